@@ -7,6 +7,7 @@
 #include <cmath>
 
 #include "EBO.hpp"
+#include "Geometry.hpp"
 #include "VAO.hpp"
 #include "VBO.hpp"
 #include "WindowManager.hpp"
@@ -15,43 +16,6 @@ constexpr GLfloat BACKGROUND_COLOR[4]   { 20.4f / 255.f, 20.4f / 255.f, 25.5f /
 constexpr unsigned int WINDOW_WIDTH	    { 800 };
 constexpr unsigned int WINDOW_HEIGHT	{ 800 };
 
-std::vector<GLfloat> generatePolygonVertices(const int nSides, const float size) {
-	constexpr float MAX_SIZE {100};
-	std::vector<GLfloat> vertices;
-
-	const float angleIncrement { static_cast<float>(2.0f * M_PI / nSides) };
-	const float normalizedSize { size / MAX_SIZE };
-
-	//Origin vertex (0.0f, 0.0f)
-	vertices.push_back(0.0f);
-	vertices.push_back(0.0f);
-
-	for (int i = 0; i < nSides; ++i) {
-		const float angle = i * angleIncrement;
-		vertices.push_back(normalizedSize * cos(angle)); // x coordinate
-		vertices.push_back(normalizedSize * sin(angle)); // y coordinate
-	}
-
-	return vertices;
-}
-
-std::vector<GLuint> generatePolygonIndices(const int nSides) {
-	std::vector<GLuint> indices;
-
-	for (int i = 1; i <= nSides; ++i) {
-		indices.push_back(0);
-		indices.push_back(i);
-
-		if (i == nSides) {
-			indices.push_back(1);
-		} else {
-			indices.push_back(i + 1);
-		}
-	}
-
-	return indices;
-}
-
 int main() {
     WindowManager windowManager;
     WindowManager::initializeGLFW(3, 3);
@@ -126,8 +90,10 @@ int main() {
     glDeleteShader(fragmentShader);
 
 	// Vertices & indices
-	std::vector vertices {generatePolygonVertices(3, 50.f)};
-	std::vector indices {generatePolygonIndices(3)};
+	const Geometry::Counts counts {Geometry::polygonCounts(3)};
+	std::vector<GLfloat> vertices(counts.vertices * 2);
+	std::vector<GLuint> indices(counts.indices);
+	Geometry::polygon({vertices.data(), 2, indices.data()}, 3, {0.0f, 0.0f}, 0.5f);
 
 	//VBO, VAO & EBO
 	const VBO vbo {vertices.data(), static_cast<GLsizeiptr>(sizeof(GLfloat) * vertices.size())};
@@ -154,7 +120,7 @@ int main() {
 		const GLint timeValueLocation = glGetUniformLocation(shaderProgram, "timeValue");
 		glUniform1f(timeValueLocation, timeValue);
 
-    	glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, nullptr);
+    	glDrawElements(GL_TRIANGLES, indices.size(), ebo.getIndexType(), nullptr);
         windowManager.endDrawing();
     }
 
@@ -100,7 +100,7 @@ int main() {
 
         glBindTexture(GL_TEXTURE_2D, texture);
         vao.bind();
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), ebo.getIndexType(), nullptr);
         VAO::unbind(); // Optional, but safe
 
         // C. Buffer swap
@@ -12,6 +12,7 @@
 #include "EBO.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "FrameData.hpp"
 
 constexpr int SCREEN_WIDTH { 800 };
 constexpr int SCREEN_HEIGHT { 600 };
@@ -59,27 +60,34 @@ int main() {
 
     const Shader SHADER("./resources/ProjectionShader.vert","./resources/ProjectionShader.frag");
     SHADER.use();
+    const Uniform<glm::mat4> TRANSFORM { SHADER.getUniform<glm::mat4>("transform") };
+    // The projection lives in the FrameData block, written once per frame for every shader.
+    const UniformBuffer frameBuffer(sizeof(FrameData), FRAME_DATA_BINDING);
+    FrameData frameData;
 
     while (!wm.windowShouldClose()) {
-        glm::mat4 projection {glm::ortho(
+        frameData.projection = glm::ortho(
             0.0f, static_cast<float>(wm.getWidth()),
             static_cast<float>(wm.getHeight()), 0.0f,
-            -1.0f, 1.0f)};
+            -1.0f, 1.0f);
+        frameData.resolution = { static_cast<float>(wm.getWidth()), static_cast<float>(wm.getHeight()) };
+        frameData.time = static_cast<float>(glfwGetTime());
+        frameBuffer.update(frameData);
+
         glm::mat4 trans {glm::mat4(1.0f)};
 
         trans = glm::translate(trans, glm::vec3(static_cast<float>(wm.getWidth())/2.f, static_cast<float>(wm.getHeight())/2.f, 0.0f));
         trans = glm::scale(trans, glm::vec3(4.f, 4.f, 1.0f));
         trans = glm::rotate(trans, static_cast<float>(glfwGetTime()), glm::vec3(0.0f, 0.0, 1.0));
 
-        SHADER.setMat4("transform", trans);
-        SHADER.setMat4("projection", projection);
+        SHADER.set(TRANSFORM, trans);
 
         glClearColor(BACKGROUND_COLOR[0], BACKGROUND_COLOR[1], BACKGROUND_COLOR[2],
             BACKGROUND_COLOR[3]);
         glClear(GL_COLOR_BUFFER_BIT);
 
         VAO.bind();
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+        glDrawElements(GL_TRIANGLES, 6, EBO.getIndexType(), nullptr);
         VAO.unbind();
 
         wm.endDrawing();
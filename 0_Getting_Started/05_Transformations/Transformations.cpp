@@ -72,7 +72,7 @@ int main() {
         glClear(GL_COLOR_BUFFER_BIT);
 
         VAO.bind();
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+        glDrawElements(GL_TRIANGLES, 6, EBO.getIndexType(), nullptr);
         VAO.unbind();
 
         wm.endDrawing();
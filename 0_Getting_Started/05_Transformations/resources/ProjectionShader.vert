@@ -7,12 +7,19 @@ out vec2 TexCoords;
 out vec3 ourColor;
 
 uniform mat4 transform;
-uniform mat4 projection; // <-- NUEVA MATRIZ
+// projection, view, time... compartidos por todos los shaders (FrameData.hpp)
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
 
 void main()
 {
-    // El orden IMPORTA: projection * transform * vertexPosition
-    gl_Position = projection * transform * vec4(vertexPosition, 0.0, 1.0);
+    // El orden IMPORTA: projection * view * transform * vertexPosition
+    gl_Position = projection * view * transform * vec4(vertexPosition, 0.0, 1.0);
 
     TexCoords = aTexCoords;
     ourColor = aColor;
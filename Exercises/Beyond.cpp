@@ -2,6 +2,7 @@
 // Created by Keal on 4/26/2026.
 //
 
+#include <cstddef>
 #include <vector>
 
 #include "WindowManager.hpp"
@@ -10,6 +11,7 @@
 #include "EBO.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "VertexPacking.hpp"
 
 constexpr int SCREEN_WIDTH { 800 };
 constexpr int SCREEN_HEIGHT { 600 };
@@ -28,25 +30,41 @@ int main() {
        -0.5f,  0.5f, 1.0, 1.0, 1.0, 0.0f, 2.0f, // Upper left corner White
    };
 
-    constexpr int STRIDE { 7 * sizeof(GLfloat) };
+    constexpr std::size_t FLOATS_PER_VERTEX { 7 };
+    const std::size_t VERTEX_COUNT { VERTICES.size() / FLOATS_PER_VERTEX };
+
+    // What the GPU gets: half float position and UV, normalized byte color. 12 bytes per vertex instead of 28.
+    struct PackedVertex {
+        GLhalf position[2];
+        GLubyte color[4];
+        GLhalf texCoords[2];
+    };
+    constexpr int STRIDE { sizeof(PackedVertex) };
+
+    std::vector<PackedVertex> packedVertices(VERTEX_COUNT);
+    VertexPacking::packHalf(VERTICES.data(), FLOATS_PER_VERTEX, 2, VERTEX_COUNT, packedVertices[0].position, STRIDE);
+    VertexPacking::packUnorm8(VERTICES.data() + 2, FLOATS_PER_VERTEX, 3, VERTEX_COUNT, packedVertices[0].color, STRIDE);
+    VertexPacking::packHalf(VERTICES.data() + 5, FLOATS_PER_VERTEX, 2, VERTEX_COUNT, packedVertices[0].texCoords,
+        STRIDE);
 
     const std::vector<GLuint> INDICES {
         0, 1, 3,
         1, 2, 3
     };
 
-    const VBO VBO((VERTICES.data()), static_cast<GLsizeiptr>(sizeof(GLfloat) * VERTICES.size()));
+    const VBO VBO(packedVertices.data(), static_cast<GLsizeiptr>(sizeof(PackedVertex) * packedVertices.size()));
     const EBO EBO((INDICES.data()), static_cast<GLsizeiptr>(sizeof(GLuint) * INDICES.size()));
     VAO VAO;
     VAO.bind();
     EBO.bind();
 
-    // Atribute 0: Position (2 floats)
-    VAO.linkAttrib(VBO, 0, 2, GL_FLOAT, STRIDE, nullptr);
-    // Atribute 1: Color (3 floats)
-    VAO.linkAttrib(VBO, 1, 3, GL_FLOAT, STRIDE, reinterpret_cast<void*>(2 * sizeof(GLfloat)));
-    // Atribute 2: Texture (3 floats)
-    VAO.linkAttrib(VBO, 2, 2, GL_FLOAT, STRIDE, reinterpret_cast<void*>(5 * sizeof(GLfloat)));
+    // Atribute 0: Position (2 half floats)
+    VAO.linkAttrib(VBO, 0, 2, GL_HALF_FLOAT, STRIDE, reinterpret_cast<void*>(offsetof(PackedVertex, position)));
+    // Atribute 1: Color (3 bytes, read as 0..1)
+    VAO.linkAttrib(VBO, 1, 3, GL_UNSIGNED_BYTE, STRIDE, reinterpret_cast<void*>(offsetof(PackedVertex, color)),
+        VAO::AttribMode::Normalized);
+    // Atribute 2: Texture (2 half floats)
+    VAO.linkAttrib(VBO, 2, 2, GL_HALF_FLOAT, STRIDE, reinterpret_cast<void*>(offsetof(PackedVertex, texCoords)));
 
     VAO::unbind();
     EBO::unbind();
@@ -66,8 +84,7 @@ int main() {
         glClear(GL_COLOR_BUFFER_BIT);
 
         VAO.bind();
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-        VAO.unbind();
+        glDrawElements(GL_TRIANGLES, 6, EBO.getIndexType(), nullptr);
 
         wm.endDrawing();
     }
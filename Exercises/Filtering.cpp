@@ -66,8 +66,7 @@ int main() {
         glClear(GL_COLOR_BUFFER_BIT);
 
         VAO.bind();
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-        VAO.unbind();
+        glDrawElements(GL_TRIANGLES, 6, EBO.getIndexType(), nullptr);
 
         wm.endDrawing();
     }
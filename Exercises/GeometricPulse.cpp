@@ -1,6 +1,4 @@
-#define _USE_MATH_DEFINES
 #include <vector>
-#include <cmath>
 #include <iostream>
 
 #include "WindowManager.hpp"
@@ -8,47 +6,14 @@
 #include "VAO.hpp"
 #include "VBO.hpp"
 #include "EBO.hpp"
+#include "Geometry.hpp"
+#include "FrameData.hpp"
 
 // --- GLOBAL CONFIGURATION ---
 constexpr unsigned int WINDOW_WIDTH  { 800 };
 constexpr unsigned int WINDOW_HEIGHT { 600 };
 constexpr GLfloat BACKGROUND_COLOR[4] { 0.1f, 0.1f, 0.15f, 1.0f }; // Elegant dark gray
 
-std::vector<GLfloat> generatePolygonVertices(const int nSides) {
-	std::vector<GLfloat> vertices;
-
-	const float angleIncrement { static_cast<float>(2.0f * M_PI / nSides) };
-
-	//Origin vertex (0.0f, 0.0f)
-	vertices.push_back(0.0f);
-	vertices.push_back(0.0f);
-
-	for (int i = 0; i < nSides; ++i) {
-		const float angle = i * angleIncrement;
-		vertices.push_back(cos(angle)); // x coordinate
-		vertices.push_back(sin(angle)); // y coordinate
-	}
-
-	return vertices;
-}
-
-std::vector<GLuint> generatePolygonIndices(const int nSides) {
-	std::vector<GLuint> indices;
-
-	for (int i = 1; i <= nSides; ++i) {
-		indices.push_back(0);
-		indices.push_back(i);
-
-		if (i == nSides) {
-			indices.push_back(1);
-		} else {
-			indices.push_back(i + 1);
-		}
-	}
-
-	return indices;
-}
-
 int main() {
     // 1. SYSTEM INITIALIZATION
     WindowManager windowManager;
@@ -57,13 +22,17 @@ int main() {
 
     // 2. SHADERS COMPILATION
     Shader shaderProgram("resources/shaders/pulse.vert", "resources/shaders/pulse.frag");
+    const UniformBuffer frameBuffer(sizeof(FrameData), FRAME_DATA_BINDING);
+    FrameData frameData;
 
     // 3. GEOMETRY DEFINITION
     int nSides {};
     std::cout << "Enter the number of sides for the polygon: ";
     std::cin >> nSides;
-    std::vector<GLfloat>vertices    { generatePolygonVertices(nSides) };
-    std::vector<GLuint> indices     { generatePolygonIndices(nSides) };
+    const Geometry::Counts counts { Geometry::polygonCounts(nSides) };
+    std::vector<GLfloat>vertices    (counts.vertices * 2);
+    std::vector<GLuint> indices     (counts.indices);
+    Geometry::polygon({ vertices.data(), 2, indices.data() }, nSides, { 0.0f, 0.0f }, 1.0f);
 
     // 4. BUFFERS CONFIGURATION
     const VBO vbo(vertices.data(), static_cast<GLsizeiptr>(sizeof(GLfloat) * vertices.size()));
@@ -88,14 +57,14 @@ int main() {
         glClearColor(BACKGROUND_COLOR[0], BACKGROUND_COLOR[1], BACKGROUND_COLOR[2], BACKGROUND_COLOR[3]);
         glClear(GL_COLOR_BUFFER_BIT);
 
+        // Uniforms, shared by every shader through the FrameData block
+        frameData.time = timeValue;
+        frameBuffer.update(frameData);
+
         shaderProgram.use();
-        
-        // Uniforms
-        shaderProgram.setFloat("time", timeValue);
 
         vao.bind();
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
-        VAO::unbind(); // Optional, but safe
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), ebo.getIndexType(), nullptr);
 
         // C. Buffer swap
         windowManager.endDrawing();
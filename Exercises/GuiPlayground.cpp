@@ -13,6 +13,9 @@
 #include "EBO.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "Profiler.hpp"
+#include "GLStateCache.hpp"
+#include "FrameData.hpp"
 
 // Includes de ImGui
 #include <imgui.h>
@@ -62,6 +65,7 @@ int main() {
     happyFace.setFilteringMode(GL_LINEAR);
 
     const Shader SHADER("./resources/shaders/ProjectionShader.vert","./resources/shaders/ProjectionShader.frag");
+    const Uniform<glm::mat4> TRANSFORM { SHADER.getUniform<glm::mat4>("transform") };
 
     // ==========================================
     // 1. INICIALIZAR IMGUI
@@ -82,17 +86,32 @@ int main() {
     glm::vec2 escala (512.f, 512.f); // Asumiendo que tu caja normalizada mida 1x1, esto la hace de 100x100 píxeles
     bool vsyncEnabled = true;
     bool wireframeModeEnabled = false;
+    float limiteFps = 0.0f; // 0 = sin limite
     // ==========================================
     // BUCLE PRINCIPAL
     // ==========================================
-    GLfloat currentTime {0};
-    GLfloat lastTime {0};
+    FrameScheduler& scheduler = wm.getScheduler();
+    Profiler profiler; // COREGL_PROFILE_OUTPUT=trace.json guarda una captura para chrome://tracing
+    float rotacionAnterior = rotacion;
+    // Proyeccion, tiempo y resolucion se suben una vez por frame para todos los shaders.
+    const UniformBuffer frameBuffer(sizeof(FrameData), FRAME_DATA_BINDING);
+    FrameData frameData;
 
     while (!wm.windowShouldClose()) {
         // --- 2. PREPARAR EL FRAME DE IMGUI ---
         wm.toggleVsync(vsyncEnabled);
-        currentTime = glfwGetTime();
-        float deltaTime = currentTime - lastTime;
+        scheduler.setTargetFrameRate(limiteFps);
+        wm.beginDrawing();
+        profiler.beginFrame();
+
+        // La rotacion avanza en pasos fijos; el render interpola entre los dos ultimos.
+        while (scheduler.stepFixedUpdate()) {
+            rotacionAnterior = rotacion;
+            rotacion += velocidadRotacion * static_cast<float>(scheduler.getFixedStepSeconds());
+        }
+        const float alpha = static_cast<float>(scheduler.getInterpolationAlpha());
+        const float rotacionRender = rotacionAnterior + (rotacion - rotacionAnterior) * alpha;
+        const float frameTime = static_cast<float>(scheduler.getSmoothedDeltaSeconds());
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
@@ -106,42 +125,54 @@ int main() {
         ImGui::SliderFloat2("Escala (X, Y)", &escala.x, 1.0f, static_cast<float>(wm.getWidth()), "%.2f");
         ImGui::Checkbox("Vsync", &vsyncEnabled);
         ImGui::Checkbox("Wireframe Mode", &wireframeModeEnabled);
-        ImGui::TextDisabled("FPS: %.1f\nframe time: %.2f\nRotacion: %.2f rads", 1.f/deltaTime, deltaTime * 1000, rotacion);
+        ImGui::SliderFloat("Limite FPS", &limiteFps, 0.0f, 240.0f, "%.0f");
+        ImGui::TextDisabled("FPS: %.1f\nframe time: %.2f\nRotacion: %.2f rads", frameTime > 0.f ? 1.f/frameTime : 0.f, frameTime * 1000, rotacion);
+        const GLStateCache::Counters& estadoGL = GLStateCache::getCounters();
+        ImGui::TextDisabled("Llamadas GL de estado: %llu emitidas, %llu evitadas",
+            static_cast<unsigned long long>(estadoGL.totalIssued()), static_cast<unsigned long long>(estadoGL.totalSkipped()));
         ImGui::End();
+        profiler.drawImGui();
 
         // --- RENDERIZADO DE TU MOTOR (OpenGL) ---
-        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        SHADER.use();
-
-        // APLICAR LAS MATRICES USANDO LAS VARIABLES DE IMGUI
-        glm::mat4 projection {glm::ortho(
-            0.0f, static_cast<float>(wm.getWidth()),
-            static_cast<float>(wm.getHeight()), 0.0f,
-            -1.0f, 1.0f)};
-
-        glm::mat4 trans = glm::mat4(1.0f);
-        trans = glm::translate(trans, glm::vec3(posicion.x, posicion.y, 0.0f));
-        rotacion += velocidadRotacion * deltaTime;
-        trans = glm::rotate(trans, glm::radians(rotacion), glm::vec3(0.0f, 0.0f, 1.0f)); // Convertimos grados a radianes
-        trans = glm::scale(trans, glm::vec3(escala, 1.0f));
-
-        SHADER.setMat4("projection", projection);
-        SHADER.setMat4("transform", trans);
-
-        wireframeModeEnabled ? glPolygonMode(GL_FRONT_AND_BACK, GL_LINE) : glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        // ... (Dibujar tu VAO con glDrawElements) ...
-        VAO.bind();
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-        VAO.unbind();
+        {
+            ProfileZone zonaEscena(profiler, "Escena");
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            frameData.projection = glm::ortho(
+                0.0f, static_cast<float>(wm.getWidth()),
+                static_cast<float>(wm.getHeight()), 0.0f,
+                -1.0f, 1.0f);
+            frameData.resolution = { static_cast<float>(wm.getWidth()), static_cast<float>(wm.getHeight()) };
+            frameData.time = static_cast<float>(glfwGetTime());
+            frameData.deltaTime = frameTime;
+            frameBuffer.update(frameData);
+
+            SHADER.use();
+
+            // APLICAR LAS MATRICES USANDO LAS VARIABLES DE IMGUI
+            glm::mat4 trans = glm::mat4(1.0f);
+            trans = glm::translate(trans, glm::vec3(posicion.x, posicion.y, 0.0f));
+            trans = glm::rotate(trans, glm::radians(rotacionRender), glm::vec3(0.0f, 0.0f, 1.0f)); // Convertimos grados a radianes
+            trans = glm::scale(trans, glm::vec3(escala, 1.0f));
+
+            SHADER.set(TRANSFORM, trans);
+
+            GLStateCache::setPolygonMode(wireframeModeEnabled ? GL_LINE : GL_FILL);
+            // ... (Dibujar tu VAO con glDrawElements) ...
+            VAO.bind();
+            glDrawElements(GL_TRIANGLES, 6, EBO.getIndexType(), nullptr);
+        }
 
         // --- 4. RENDERIZAR IMGUI SOBRE TU JUEGO ---
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            ProfileZone zonaImGui(profiler, "ImGui");
+            ImGui::Render();
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
 
+        profiler.endFrame();
         wm.endDrawing();
-        lastTime = currentTime;
     }
 
     // ==========================================
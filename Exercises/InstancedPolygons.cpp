@@ -0,0 +1,98 @@
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "WindowManager.hpp"
+#include "Shader.hpp"
+#include "VAO.hpp"
+#include "VBO.hpp"
+#include "EBO.hpp"
+#include "Geometry.hpp"
+#include "FrameData.hpp"
+
+constexpr int SCREEN_WIDTH { 800 };
+constexpr int SCREEN_HEIGHT { 600 };
+
+constexpr float BACKGROUND_COLOR[4] { 0.1f, 0.1f, 0.15f, 1.0f };
+
+constexpr int POLYGON_SIDES { 6 };
+constexpr int INSTANCE_COLUMNS { 80 };
+constexpr int INSTANCE_ROWS { 60 };
+
+int main() {
+    WindowManager::initializeGLFW(3, 3);
+    WindowManager wm;
+    wm.initializeWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Instanced Polygons");
+
+    // One unit hexagon (triangle fan as a list) shared by every instance.
+    const Geometry::Counts counts { Geometry::polygonCounts(POLYGON_SIDES) };
+    std::vector<GLfloat> vertices(counts.vertices * 2);
+    std::vector<GLuint> indices(counts.indices);
+    Geometry::polygon({ vertices.data(), 2, indices.data() }, POLYGON_SIDES, { 0.0f, 0.0f }, 1.0f);
+
+    // Per-instance data: mat4 transform (16 floats) + RGBA color (4 floats).
+    constexpr int INSTANCE_FLOATS { 20 };
+    constexpr int INSTANCE_STRIDE { INSTANCE_FLOATS * sizeof(GLfloat) };
+    constexpr int INSTANCE_COUNT { INSTANCE_COLUMNS * INSTANCE_ROWS };
+
+    std::vector<GLfloat> instances;
+    instances.reserve(INSTANCE_COUNT * INSTANCE_FLOATS);
+    const glm::vec2 cell { static_cast<float>(SCREEN_WIDTH) / INSTANCE_COLUMNS,
+                           static_cast<float>(SCREEN_HEIGHT) / INSTANCE_ROWS };
+    for (int row = 0; row < INSTANCE_ROWS; ++row) {
+        for (int column = 0; column < INSTANCE_COLUMNS; ++column) {
+            glm::mat4 transform { glm::mat4(1.0f) };
+            transform = glm::translate(transform, glm::vec3((column + 0.5f) * cell.x, (row + 0.5f) * cell.y, 0.0f));
+            transform = glm::scale(transform, glm::vec3(0.45f * cell.x, 0.45f * cell.y, 1.0f));
+            const float* matrix { glm::value_ptr(transform) };
+            instances.insert(instances.end(), matrix, matrix + 16);
+
+            instances.push_back(static_cast<float>(column) / INSTANCE_COLUMNS);
+            instances.push_back(static_cast<float>(row) / INSTANCE_ROWS);
+            instances.push_back(0.8f);
+            instances.push_back(1.0f);
+        }
+    }
+
+    const VBO meshVBO(vertices.data(), static_cast<GLsizeiptr>(sizeof(GLfloat) * vertices.size()));
+    const VBO instanceVBO(instances.data(), static_cast<GLsizeiptr>(sizeof(GLfloat) * instances.size()));
+    const EBO ebo(indices.data(), static_cast<GLsizeiptr>(sizeof(GLuint) * indices.size()));
+    VAO vao;
+    vao.bind();
+    ebo.bind();
+
+    // Atribute 0: Position (2 floats, per vertex)
+    vao.linkAttrib(meshVBO, 0, 2, GL_FLOAT, 2 * sizeof(GLfloat), nullptr);
+    // Atributes 1-4: Transform (mat4, per instance)
+    vao.linkInstanceMat4(instanceVBO, 1, INSTANCE_STRIDE, nullptr);
+    // Atribute 5: Color (4 floats, per instance)
+    vao.linkInstanceAttrib(instanceVBO, 5, 4, GL_FLOAT, INSTANCE_STRIDE, reinterpret_cast<void*>(16 * sizeof(GLfloat)));
+
+    VAO::unbind();
+    EBO::unbind();
+
+    const Shader SHADER("./resources/shaders/InstancedShader.vert", "./resources/shaders/InstancedShader.frag");
+    const UniformBuffer frameBuffer(sizeof(FrameData), FRAME_DATA_BINDING);
+    FrameData frameData;
+    frameData.projection = glm::ortho(0.0f, static_cast<float>(SCREEN_WIDTH),
+                                      static_cast<float>(SCREEN_HEIGHT), 0.0f, -1.0f, 1.0f);
+    frameData.resolution = { static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT) };
+
+    while (!wm.windowShouldClose()) {
+        glClearColor(BACKGROUND_COLOR[0], BACKGROUND_COLOR[1], BACKGROUND_COLOR[2], BACKGROUND_COLOR[3]);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        frameData.time = static_cast<float>(glfwGetTime());
+        frameBuffer.update(frameData);
+
+        SHADER.use();
+
+        // 4800 hexagons, one draw call.
+        vao.drawElementsInstanced(GL_TRIANGLES, ebo.getCount(), ebo.getIndexType(), INSTANCE_COUNT);
+
+        wm.endDrawing();
+    }
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "WindowManager.hpp"
+#include "Shader.hpp"
+#include "VBO.hpp"
+#include "MeshArena.hpp"
+#include "DrawList.hpp"
+#include "Geometry.hpp"
+#include "FrameData.hpp"
+
+constexpr int SCREEN_WIDTH { 800 };
+constexpr int SCREEN_HEIGHT { 600 };
+
+constexpr float BACKGROUND_COLOR[4] { 0.1f, 0.1f, 0.15f, 1.0f };
+
+constexpr int DRAW_COLUMNS { 80 };
+constexpr int DRAW_ROWS { 60 };
+
+int main() {
+    // glMultiDrawElementsIndirect is GL 4.3.
+    WindowManager::initializeGLFW(4, 3);
+    WindowManager wm;
+    wm.initializeWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Multi Draw");
+
+    if (!DrawList::isSupported()) {
+        std::cout << "MultiDraw needs an OpenGL 4.2 context for per-draw data" << std::endl;
+        glfwTerminate();
+        return 1;
+    }
+
+    // Different unit shapes in one arena: triangle to octagon, a ring and a rounded square. Each is reordered
+    // for the vertex cache on the way in; they are flat, so there is no overdraw pass.
+    MeshArena arena(2 * sizeof(GLfloat));
+    std::vector<MeshArena::Mesh> meshes;
+    const auto addShape { [&arena, &meshes](const Geometry::Counts counts, const auto& write) {
+        std::vector<GLfloat> vertices(counts.vertices * 2);
+        std::vector<GLuint> indices(counts.indices);
+        write(Geometry::Target { vertices.data(), 2, indices.data() });
+        meshes.push_back(arena.addOptimized(std::move(vertices), std::move(indices), 2));
+    } };
+    for (int sides = 3; sides <= 8; ++sides) {
+        addShape(Geometry::polygonCounts(sides), [sides](const Geometry::Target& target) {
+            Geometry::polygon(target, sides, { 0.0f, 0.0f }, 1.0f);
+        });
+    }
+    addShape(Geometry::ringCounts(24), [](const Geometry::Target& target) {
+        Geometry::ring(target, 24, { 0.0f, 0.0f }, 0.5f, 1.0f);
+    });
+    addShape(Geometry::roundedRectCounts(4), [](const Geometry::Target& target) {
+        Geometry::roundedRect(target, { 0.0f, 0.0f }, { 1.6f, 1.6f }, 0.4f, 4);
+    });
+    arena.build();
+
+    // One draw per cell, each with its own shape. Per-draw data: mat4 transform (16 floats) + RGBA color
+    // (4 floats), read through the base instance add() hands out.
+    constexpr int DRAW_FLOATS { 20 };
+    constexpr int DRAW_STRIDE { DRAW_FLOATS * sizeof(GLfloat) };
+    constexpr int DRAW_COUNT { DRAW_COLUMNS * DRAW_ROWS };
+
+    DrawList drawList(DRAW_COUNT);
+    std::vector<GLfloat> perDraw(DRAW_COUNT * DRAW_FLOATS);
+    const glm::vec2 cell { static_cast<float>(SCREEN_WIDTH) / DRAW_COLUMNS,
+                           static_cast<float>(SCREEN_HEIGHT) / DRAW_ROWS };
+    for (int row = 0; row < DRAW_ROWS; ++row) {
+        for (int column = 0; column < DRAW_COLUMNS; ++column) {
+            const MeshArena::Mesh& mesh { meshes[static_cast<std::size_t>(row + column) % meshes.size()] };
+            GLfloat* record { perDraw.data() + static_cast<std::size_t>(drawList.add(mesh)) * DRAW_FLOATS };
+
+            glm::mat4 transform { glm::mat4(1.0f) };
+            transform = glm::translate(transform, glm::vec3((column + 0.5f) * cell.x, (row + 0.5f) * cell.y, 0.0f));
+            transform = glm::scale(transform, glm::vec3(0.45f * cell.x, 0.45f * cell.y, 1.0f));
+            const float* matrix { glm::value_ptr(transform) };
+            std::copy(matrix, matrix + 16, record);
+
+            record[16] = static_cast<float>(column) / DRAW_COLUMNS;
+            record[17] = static_cast<float>(row) / DRAW_ROWS;
+            record[18] = 0.8f;
+            record[19] = 1.0f;
+        }
+    }
+
+    const VBO perDrawVBO(perDraw.data(), static_cast<GLsizeiptr>(sizeof(GLfloat) * perDraw.size()));
+    VAO& vao { arena.getVAO() };
+    // Atribute 0: Position (2 floats, per vertex)
+    vao.linkAttrib(arena.getVBO(), 0, 2, GL_FLOAT, arena.getStride(), nullptr);
+    // Atributes 1-4: Transform (mat4, per draw)
+    vao.linkInstanceMat4(perDrawVBO, 1, DRAW_STRIDE, nullptr);
+    // Atribute 5: Color (4 floats, per draw)
+    vao.linkInstanceAttrib(perDrawVBO, 5, 4, GL_FLOAT, DRAW_STRIDE, reinterpret_cast<void*>(16 * sizeof(GLfloat)));
+    VAO::unbind();
+
+    // The same shader as InstancedPolygons: to it every draw is an instance.
+    const Shader SHADER("./resources/shaders/InstancedShader.vert", "./resources/shaders/InstancedShader.frag");
+    const UniformBuffer frameBuffer(sizeof(FrameData), FRAME_DATA_BINDING);
+    FrameData frameData;
+    frameData.projection = glm::ortho(0.0f, static_cast<float>(SCREEN_WIDTH),
+                                      static_cast<float>(SCREEN_HEIGHT), 0.0f, -1.0f, 1.0f);
+    frameData.resolution = { static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT) };
+
+    std::cout << DRAW_COUNT << " draws per frame, "
+              << (drawList.isMultiDrawIndirect() ? "one glMultiDrawElementsIndirect" : "one call each") << std::endl;
+
+    while (!wm.windowShouldClose()) {
+        glClearColor(BACKGROUND_COLOR[0], BACKGROUND_COLOR[1], BACKGROUND_COLOR[2], BACKGROUND_COLOR[3]);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        frameData.time = static_cast<float>(glfwGetTime());
+        frameBuffer.update(frameData);
+
+        SHADER.use();
+        drawList.submit(arena);
+        drawList.endFrame();
+
+        wm.endDrawing();
+    }
+    glfwTerminate();
+    return 0;
+}
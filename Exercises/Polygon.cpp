@@ -2,55 +2,18 @@
 // Created by Keal on 4/13/2026.
 //
 
-#define _USE_MATH_DEFINES
 #include <vector>
-#include <cmath>
 
 #include "VAO.hpp"
 #include "VBO.hpp"
 #include "EBO.hpp"
+#include "Geometry.hpp"
 #include "WindowManager.hpp"
 
 constexpr GLfloat BACKGROUND_COLOR[4]   { 20.4f / 255.f, 20.4f / 255.f, 25.5f / 255.f, 1.f };
 constexpr unsigned int WINDOW_WIDTH	    { 800 };
 constexpr unsigned int WINDOW_HEIGHT	{ 800 };
-
-std::vector<GLfloat> generatePolygonVertices(const int nSides, const float size) {
-	constexpr float MAX_SIZE {100};
-	std::vector<GLfloat> vertices;
-
-	const float angleIncrement { static_cast<float>(2.0f * M_PI / nSides) };
-	const float normalizedSize { size / MAX_SIZE };
-
-	//Origin vertex (0.0f, 0.0f)
-	vertices.push_back(0.0f);
-	vertices.push_back(0.0f);
-
-	for (int i = 0; i < nSides; ++i) {
-		const float angle = i * angleIncrement;
-		vertices.push_back(normalizedSize * cos(angle)); // x coordinate
-		vertices.push_back(normalizedSize * sin(angle)); // y coordinate
-	}
-
-	return vertices;
-}
-
-std::vector<GLuint> generatePolygonIndices(const int nSides) {
-	std::vector<GLuint> indices;
-
-	for (int i = 1; i <= nSides; ++i) {
-		indices.push_back(0);
-		indices.push_back(i);
-
-		if (i == nSides) {
-			indices.push_back(1);
-		} else {
-			indices.push_back(i + 1);
-		}
-	}
-
-	return indices;
-}
+constexpr float MAX_POLYGON_SIZE		{ 100.f }; // Sizes entered by the user go from 0 to 100
 
 int main() {
     WindowManager windowManager;
@@ -133,8 +96,10 @@ int main() {
     std::cin >> size;
 
 	// Vertices & indices
-	std::vector vertices {generatePolygonVertices(nSides, size)};
-	std::vector indices {generatePolygonIndices(nSides)};
+	const Geometry::Counts counts {Geometry::polygonCounts(nSides)};
+	std::vector<GLfloat> vertices(counts.vertices * 2);
+	std::vector<GLuint> indices(counts.indices);
+	Geometry::polygon({vertices.data(), 2, indices.data()}, nSides, {0.0f, 0.0f}, size / MAX_POLYGON_SIZE);
 
 	//VBO, VAO & EBO
 	const VBO vbo {vertices.data(), static_cast<GLsizeiptr>(sizeof(GLfloat) * vertices.size())};
@@ -156,7 +121,7 @@ int main() {
 
     	glUseProgram(shaderProgram);
     	vao.bind();
-    	glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, nullptr);
+    	glDrawElements(GL_TRIANGLES, indices.size(), ebo.getIndexType(), nullptr);
         windowManager.endDrawing();
     }
 
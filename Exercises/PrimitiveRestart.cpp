@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "WindowManager.hpp"
+#include "Shader.hpp"
+#include "VAO.hpp"
+#include "VBO.hpp"
+#include "EBO.hpp"
+#include "Geometry.hpp"
+#include "GLStateCache.hpp"
+#include "FrameData.hpp"
+
+constexpr int SCREEN_WIDTH { 800 };
+constexpr int SCREEN_HEIGHT { 600 };
+
+constexpr float BACKGROUND_COLOR[4] { 0.1f, 0.1f, 0.15f, 1.0f };
+
+constexpr int SHAPE_COLUMNS { 16 };
+constexpr int SHAPE_ROWS { 12 };
+
+// One batch uploaded as its own VBO/EBO pair behind one VAO.
+struct BatchBuffers {
+    VBO vbo;
+    EBO ebo;
+    VAO vao;
+    GLenum mode;
+
+    explicit BatchBuffers(const Geometry::Batch& batch)
+        : vbo(batch.getPositions().data(), static_cast<GLsizeiptr>(sizeof(GLfloat) * batch.getPositions().size())),
+          ebo(batch.getIndices().data(), static_cast<GLsizeiptr>(sizeof(GLuint) * batch.getIndices().size())),
+          mode(batch.getPrimitiveMode()) {
+        vao.setElementBuffer(ebo);
+        // Atribute 0: Position (2 floats)
+        vao.linkAttrib(vbo, 0, 2, GL_FLOAT, 2 * sizeof(GLfloat), nullptr);
+        VAO::unbind();
+    }
+
+    void draw() const {
+        vao.bind();
+        GLStateCache::setPrimitiveRestart(true, ebo.getIndexType());
+        glDrawElements(mode, ebo.getCount(), ebo.getIndexType(), nullptr);
+    }
+};
+
+int main() {
+    WindowManager::initializeGLFW(3, 3);
+    WindowManager wm;
+    wm.initializeWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Primitive Restart");
+
+    // Polygons and rounded squares are fans, rings are strips: two batches, two draw calls for the whole grid.
+    Geometry::Batch fans(Geometry::Topology::Fan);
+    Geometry::Batch strips(Geometry::Topology::Strip);
+    const glm::vec2 cell { 2.0f / SHAPE_COLUMNS, 2.0f / SHAPE_ROWS };
+    const float radius { 0.4f * std::min(cell.x, cell.y) };
+    for (int row = 0; row < SHAPE_ROWS; ++row) {
+        for (int column = 0; column < SHAPE_COLUMNS; ++column) {
+            const glm::vec2 center { -1.0f + (column + 0.5f) * cell.x, -1.0f + (row + 0.5f) * cell.y };
+            switch ((row + column) % 3) {
+                case 0: {
+                    const int sides { 3 + (row * SHAPE_COLUMNS + column) % 6 };
+                    Geometry::polygon(fans.add(Geometry::polygonCounts(sides, Geometry::Topology::Fan)), sides, center,
+                        radius, Geometry::Topology::Fan);
+                    break;
+                }
+                case 1:
+                    Geometry::roundedRect(fans.add(Geometry::roundedRectCounts(3, Geometry::Topology::Fan)), center,
+                        { 2.0f * radius, 2.0f * radius }, 0.4f * radius, 3, Geometry::Topology::Fan);
+                    break;
+                default:
+                    Geometry::ring(strips.add(Geometry::ringCounts(24, Geometry::Topology::Strip)), 24, center,
+                        0.5f * radius, radius, Geometry::Topology::Strip);
+                    break;
+            }
+        }
+    }
+    const BatchBuffers fanBuffers(fans);
+    const BatchBuffers stripBuffers(strips);
+
+    const Shader SHADER("./resources/shaders/pulse.vert", "./resources/shaders/canvas.frag");
+    const UniformBuffer frameBuffer(sizeof(FrameData), FRAME_DATA_BINDING);
+    FrameData frameData;
+    frameData.resolution = { static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT) };
+
+    std::cout << SHAPE_COLUMNS * SHAPE_ROWS << " shapes in 2 draw calls" << std::endl;
+
+    while (!wm.windowShouldClose()) {
+        glClearColor(BACKGROUND_COLOR[0], BACKGROUND_COLOR[1], BACKGROUND_COLOR[2], BACKGROUND_COLOR[3]);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        frameData.time = static_cast<float>(glfwGetTime());
+        frameBuffer.update(frameData);
+
+        SHADER.use();
+        fanBuffers.draw();
+        stripBuffers.draw();
+
+        wm.endDrawing();
+    }
+    glfwTerminate();
+    return 0;
+}
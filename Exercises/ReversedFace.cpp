@@ -136,8 +136,7 @@ int main() {
         glActiveTexture(GL_TEXTURE1);
         glBindTexture(GL_TEXTURE_2D, happyFaceTexture);
         vao.bind();
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
-        VAO::unbind(); // Optional, but safe
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), ebo.getIndexType(), nullptr);
 
         // C. Buffer swap
         windowManager.endDrawing();
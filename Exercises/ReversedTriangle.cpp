@@ -55,8 +55,7 @@ int main() {
         shaderProgram.use();
 
         vao.bind();
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
-        VAO::unbind();
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), ebo.getIndexType(), nullptr);
 
         windowManager.endDrawing();
     }
@@ -10,6 +10,7 @@
 #include "EBO.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "FrameData.hpp"
 
 constexpr int SCREEN_WIDTH { 800 };
 constexpr int SCREEN_HEIGHT { 600 };
@@ -53,19 +54,19 @@ int main() {
 
     const Shader shader("./resources/shaders/ScrollShader.vert","./resources/shaders/ScrollShader.frag");
     shader.use();
+    const UniformBuffer frameBuffer(sizeof(FrameData), FRAME_DATA_BINDING);
+    FrameData frameData;
 
     while (!wm.windowShouldClose()) {
-        const float timeValue { static_cast<float>(glfwGetTime()) };
-
-        shader.setFloat("timeValue", timeValue);
+        frameData.time = static_cast<float>(glfwGetTime());
+        frameBuffer.update(frameData);
 
         glClearColor(BACKGROUND_COLOR[0], BACKGROUND_COLOR[1], BACKGROUND_COLOR[2],
             BACKGROUND_COLOR[3]);
         glClear(GL_COLOR_BUFFER_BIT);
 
         vao.bind();
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
-        vao.unbind();
+        glDrawElements(GL_TRIANGLES, 6, ebo.getIndexType(), nullptr);
 
         wm.endDrawing();
     }
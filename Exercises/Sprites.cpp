@@ -0,0 +1,66 @@
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "WindowManager.hpp"
+#include "Shader.hpp"
+#include "TextureAtlas.hpp"
+#include "SpriteBatch.hpp"
+#include "FrameData.hpp"
+
+constexpr int SCREEN_WIDTH { 800 };
+constexpr int SCREEN_HEIGHT { 600 };
+
+constexpr float BACKGROUND_COLOR[4] { 20.4f / 255.f, 20.4f / 255.f, 25.5f / 255.f, 1.f };
+
+constexpr int GRID_COLUMNS { 200 };
+constexpr int GRID_ROWS { 150 };
+
+int main() {
+    WindowManager::initializeGLFW(3, 3);
+    WindowManager wm;
+    wm.initializeWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Sprites");
+
+    // Both images go into one atlas page, so they share a texture and the sprites below one draw call.
+    TextureAtlas atlas;
+    const TextureAtlas::Region happyFace { atlas.add("./resources/textures/awesomeface.png") };
+    const TextureAtlas::Region container { atlas.add("./resources/textures/container.jpg") };
+
+    const Shader SHADER("./resources/shaders/SpriteShader.vert", "./resources/shaders/SpriteShader.frag");
+    const UniformBuffer frameBuffer(sizeof(FrameData), FRAME_DATA_BINDING);
+    FrameData frameData;
+
+    // 30000 sprites, alternating images of the same page: a single draw call.
+    SpriteBatch batch(GRID_COLUMNS * GRID_ROWS);
+
+    while (!wm.windowShouldClose()) {
+        const float time { static_cast<float>(glfwGetTime()) };
+        const float widthF { static_cast<float>(wm.getWidth()) };
+        const float heightF { static_cast<float>(wm.getHeight()) };
+
+        glClearColor(BACKGROUND_COLOR[0], BACKGROUND_COLOR[1], BACKGROUND_COLOR[2], BACKGROUND_COLOR[3]);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        frameData.projection = glm::ortho(0.0f, widthF, heightF, 0.0f, -1.0f, 1.0f);
+        frameData.resolution = { widthF, heightF };
+        frameData.time = time;
+        frameBuffer.update(frameData);
+
+        const glm::vec2 cell { widthF / GRID_COLUMNS, heightF / GRID_ROWS };
+        for (int row = 0; row < GRID_ROWS; ++row) {
+            for (int column = 0; column < GRID_COLUMNS; ++column) {
+                const glm::vec2 position { (static_cast<float>(column) + 0.5f) * cell.x,
+                                           (static_cast<float>(row) + 0.5f) * cell.y };
+                const float phase { time + static_cast<float>(row + column) * 0.1f };
+                const glm::vec3 color { 0.6f + 0.4f * std::sin(phase), 0.6f + 0.4f * std::cos(phase), 1.0f };
+                const TextureAtlas::Region& image { (row + column) % 2 == 0 ? happyFace : container };
+                batch.draw(SHADER, *image.texture, position, cell, phase, color, image.uvRect);
+            }
+        }
+        batch.end();
+
+        wm.endDrawing();
+    }
+    glfwTerminate();
+    return 0;
+}
@@ -66,8 +66,7 @@ int main() {
         // shaderProgram.setFloat("time", timeValue);
 
         vao.bind();
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
-        VAO::unbind(); // Optional, but safe
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), ebo.getIndexType(), nullptr);
 
         // C. Buffer swap
         windowManager.endDrawing();
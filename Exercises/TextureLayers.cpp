@@ -0,0 +1,105 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "WindowManager.hpp"
+#include "Shader.hpp"
+#include "Texture.hpp"
+#include "TextureArray.hpp"
+#include "BindlessTextureTable.hpp"
+#include "SpriteBatch.hpp"
+#include "FrameData.hpp"
+
+constexpr int SCREEN_WIDTH { 800 };
+constexpr int SCREEN_HEIGHT { 600 };
+
+constexpr float BACKGROUND_COLOR[4] { 20.4f / 255.f, 20.4f / 255.f, 25.5f / 255.f, 1.f };
+
+constexpr int GRID_COLUMNS { 200 };
+constexpr int GRID_ROWS { 150 };
+
+constexpr const char* IMAGES[2] { "./resources/textures/awesomeface.png", "./resources/textures/container.jpg" };
+
+int main() {
+    WindowManager::initializeGLFW(3, 3);
+    WindowManager wm;
+    wm.initializeWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Texture Layers");
+
+    // Both 512x512 images become layers of one array: the shader picks the layer per sprite, with full
+    // mip chains and no atlas gutters.
+    TextureArray layers(512, 512, 2);
+    const GLint layerIds[2] { layers.addLayer(IMAGES[0]), layers.addLayer(IMAGES[1]) };
+    const Shader ARRAY_SHADER("./resources/shaders/SpriteArrayShader.vert", "./resources/shaders/SpriteArrayShader.frag");
+
+    // With bindless textures the images stay separate textures and the shader reads their handles instead.
+    // Sprites of one draw pick different handles, which needs GL_NV_gpu_shader5 on top of the extension.
+    bool bindless { BindlessTextureTable::isSupported() && BindlessTextureTable::hasDivergentHandles() };
+    std::unique_ptr<Texture> textures[2];
+    std::unique_ptr<Shader> bindlessShader;
+    BindlessTextureTable table;
+    std::uint32_t slots[2] {};
+    for (int i = 0; bindless && i < 2; ++i) {
+        textures[i] = std::make_unique<Texture>(IMAGES[i], GL_TEXTURE_2D, GL_TEXTURE0);
+        const std::optional<std::uint32_t> slot { table.add(*textures[i]) };
+        bindless = slot.has_value();
+        slots[i] = slot.value_or(0);
+    }
+    if (bindless) {
+        bindlessShader = std::make_unique<Shader>("./resources/shaders/SpriteArrayShader.vert",
+                                                  "./resources/shaders/SpriteBindlessShader.frag");
+    }
+    std::cout << "Texture arrays" << (bindless ? " + bindless textures (B to switch)" : "") << std::endl;
+    // Both shaders read the projection from the same block.
+    const UniformBuffer frameBuffer(sizeof(FrameData), FRAME_DATA_BINDING);
+    FrameData frameData;
+
+    // 30000 sprites alternating two images: a single draw call either way.
+    SpriteBatch batch(GRID_COLUMNS * GRID_ROWS);
+    bool useBindless { bindless };
+    bool switchHeld { false };
+
+    while (!wm.windowShouldClose()) {
+        const bool switchDown { glfwGetKey(wm.getWindow(), GLFW_KEY_B) == GLFW_PRESS };
+        if (bindless && switchDown && !switchHeld) {
+            useBindless = !useBindless;
+        }
+        switchHeld = switchDown;
+
+        const float time { static_cast<float>(glfwGetTime()) };
+        const float widthF { static_cast<float>(wm.getWidth()) };
+        const float heightF { static_cast<float>(wm.getHeight()) };
+        frameData.projection = glm::ortho(0.0f, widthF, heightF, 0.0f, -1.0f, 1.0f);
+        frameData.resolution = { widthF, heightF };
+        frameData.time = time;
+        frameBuffer.update(frameData);
+
+        glClearColor(BACKGROUND_COLOR[0], BACKGROUND_COLOR[1], BACKGROUND_COLOR[2], BACKGROUND_COLOR[3]);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        const Shader& shader { useBindless ? *bindlessShader : ARRAY_SHADER };
+
+        const glm::vec2 cell { widthF / GRID_COLUMNS, heightF / GRID_ROWS };
+        for (int row = 0; row < GRID_ROWS; ++row) {
+            for (int column = 0; column < GRID_COLUMNS; ++column) {
+                const glm::vec2 position { (static_cast<float>(column) + 0.5f) * cell.x,
+                                           (static_cast<float>(row) + 0.5f) * cell.y };
+                const float phase { time + static_cast<float>(row + column) * 0.1f };
+                const glm::vec3 color { 0.6f + 0.4f * std::sin(phase), 0.6f + 0.4f * std::cos(phase), 1.0f };
+                const int image { (row + column) % 2 };
+                if (useBindless) {
+                    batch.draw(shader, table, slots[image], position, cell, phase, color);
+                } else {
+                    batch.draw(shader, layers, layerIds[image], position, cell, phase, color);
+                }
+            }
+        }
+        batch.end();
+
+        wm.endDrawing();
+    }
+    glfwTerminate();
+    return 0;
+}
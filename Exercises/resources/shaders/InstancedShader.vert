@@ -0,0 +1,25 @@
+#version 330 core
+layout (location = 0) in vec2 vertexPosition;
+// Per-instance attributes (divisor 1)
+layout (location = 1) in mat4 instanceTransform; // Takes locations 1 to 4
+layout (location = 5) in vec4 instanceColor;
+
+out vec4 ourColor;
+
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
+
+void main()
+{
+    // Every instance spins at its own speed, taken from the color so no extra attribute is needed.
+    float angle = time * (instanceColor.r - 0.5) * 4.0;
+    mat2 spin = mat2(cos(angle), sin(angle), -sin(angle), cos(angle));
+
+    gl_Position = projection * view * instanceTransform * vec4(spin * vertexPosition, 0.0, 1.0);
+    ourColor = instanceColor;
+}
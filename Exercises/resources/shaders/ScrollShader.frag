@@ -3,10 +3,16 @@
 in vec2 TexCoords;
 out vec4 FragColor;
 uniform sampler2D texture1;
-uniform float timeValue;
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
 
 void main()
 {
     float scrollSpeed = 0.2; // Adjust this value to change the scrolling speed
-    FragColor = texture(texture1, vec2(TexCoords.x + timeValue * scrollSpeed, TexCoords.y));
+    FragColor = texture(texture1, vec2(TexCoords.x + time * scrollSpeed, TexCoords.y));
 }
\ No newline at end of file
@@ -0,0 +1,13 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+in vec3 ourColor;
+flat in int layer;
+
+uniform sampler2DArray ourTextures;
+
+void main()
+{
+    FragColor = texture(ourTextures, vec3(TexCoords, layer)) * vec4(ourColor, 1.0);
+}
@@ -0,0 +1,27 @@
+#version 330 core
+layout (location = 0) in vec2 vertexPosition;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in float aLayer;
+
+out vec2 TexCoords;
+out vec3 ourColor;
+flat out int layer;
+
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
+
+void main()
+{
+    gl_Position = projection * view * vec4(vertexPosition, 0.0, 1.0);
+
+    TexCoords = aTexCoords;
+    ourColor = aColor;
+    // Texture array layer or bindless table slot, the same for the four corners of a sprite.
+    layer = int(aLayer + 0.5);
+}
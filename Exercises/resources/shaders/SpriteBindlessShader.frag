@@ -0,0 +1,20 @@
+#version 430 core
+#extension GL_ARB_bindless_texture : require
+// Lets the handle differ between the sprites of one draw; ARB_bindless_texture alone requires it to be
+// dynamically uniform.
+#extension GL_NV_gpu_shader5 : require
+out vec4 FragColor;
+
+in vec2 TexCoords;
+in vec3 ourColor;
+flat in int layer;
+
+// Filled by BindlessTextureTable, bound to SpriteBatch::TEXTURE_HANDLE_BINDING.
+layout (std430, binding = 0) readonly buffer TextureHandles {
+    uvec2 handles[];
+};
+
+void main()
+{
+    FragColor = texture(sampler2D(handles[layer]), TexCoords) * vec4(ourColor, 1.0);
+}
@@ -0,0 +1,12 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 ourColor;
+in vec2 TexCoords;
+
+uniform sampler2D ourTexture;
+
+void main()
+{
+    FragColor = texture(ourTexture, TexCoords) * vec4(ourColor, 1.0);
+}
\ No newline at end of file
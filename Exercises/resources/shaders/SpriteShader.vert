@@ -0,0 +1,24 @@
+#version 330 core
+layout (location = 0) in vec2 vertexPosition;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec2 aTexCoords;
+
+out vec2 TexCoords;
+out vec3 ourColor;
+
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
+
+void main()
+{
+    // SpriteBatch already transformed every vertex, only the camera is left.
+    gl_Position = projection * view * vec4(vertexPosition, 0.0, 1.0);
+
+    TexCoords = aTexCoords;
+    ourColor = aColor;
+}
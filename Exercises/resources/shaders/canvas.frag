@@ -1,6 +1,12 @@
 #version 330
 out vec4 FragColor;
-uniform vec2 resolution;
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
 void main()
 {
     FragColor = vec4(gl_FragCoord.x / resolution.x, gl_FragCoord.y / resolution.y, .8f, 1.0f);
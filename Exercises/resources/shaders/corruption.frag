@@ -2,11 +2,17 @@
 
 out vec4 FragColor;
 in vec2 ourPos;
-uniform float timeValue;
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
 
 void main()
 {
-    float circleRadius = 0.5 + 0.5 * sin(timeValue);
+    float circleRadius = 0.5 + 0.5 * sin(time);
     float myDistance = distance(ourPos, vec2(0.0, 0.0));
     float myStep = step(circleRadius, myDistance);
     FragColor = vec4(myDistance, myStep, myStep, 1.0);
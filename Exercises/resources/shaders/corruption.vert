@@ -2,11 +2,17 @@
 
 layout (location = 0) in vec2 aPos;
 out vec2 ourPos;
-uniform float timeValue;
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
 
 void main()
 {
-    float scale = sin(timeValue)/4.f + 0.75f;
+    float scale = sin(time)/4.f + 0.75f;
     gl_Position = vec4(aPos.x * scale, aPos.y * scale, 0.0, 1.0);
     ourPos = aPos;
 }
\ No newline at end of file
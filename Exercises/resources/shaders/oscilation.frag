@@ -1,6 +1,12 @@
 #version 330
 out vec4 FragColor;
-uniform float time;
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
 vec3 colorA = vec3(1.0f, 0.0f, 0.0f);
 vec3 colorB = vec3(0.0f, 0.0f, 1.0f);
 vec3 color;
@@ -1,6 +1,12 @@
 #version 330
 layout (location = 0) in vec2 aPos;
-uniform float time;
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec2 resolution;
+    float time;
+    float deltaTime;
+};
 float scale;
 
 void main()
@@ -0,0 +1,66 @@
+# Runs each exercise for a fixed number of frames and merges their FrameBenchmark reports.
+# Invoked by the bench_frames target:
+#   cmake -DBENCH_SCENES="name=path;..." -DBENCH_FRAMES=300 -DBENCH_WARMUP=30 -DBENCH_HEADLESS=ON
+#         -DBENCH_OUTPUT_DIR=<dir> -P RunFrameBenchmarks.cmake
+
+file(MAKE_DIRECTORY ${BENCH_OUTPUT_DIR})
+
+# The polygon exercises ask for a side count (and Polygon for a size) on stdin.
+set(BENCH_STDIN ${BENCH_OUTPUT_DIR}/stdin.txt)
+file(WRITE ${BENCH_STDIN} "64\n50\n")
+
+set(BENCH_ENV COREGL_BENCH_FRAMES=${BENCH_FRAMES} COREGL_BENCH_WARMUP=${BENCH_WARMUP})
+if(BENCH_HEADLESS)
+  list(APPEND BENCH_ENV COREGL_HEADLESS=1)
+endif()
+
+set(SCENES_JSON "")
+set(FAILED "")
+foreach(ENTRY ${BENCH_SCENES})
+  string(FIND "${ENTRY}" "=" SPLIT)
+  string(SUBSTRING "${ENTRY}" 0 ${SPLIT} SCENE)
+  math(EXPR SPLIT "${SPLIT} + 1")
+  string(SUBSTRING "${ENTRY}" ${SPLIT} -1 EXECUTABLE)
+  get_filename_component(WORKING_DIR ${EXECUTABLE} DIRECTORY)
+
+  set(REPORT ${BENCH_OUTPUT_DIR}/${SCENE}.json)
+  file(REMOVE ${REPORT})
+
+  message(STATUS "bench_frames: ${SCENE}")
+  execute_process(
+          COMMAND ${CMAKE_COMMAND} -E env ${BENCH_ENV}
+          COREGL_BENCH_SCENE=${SCENE} COREGL_BENCH_OUTPUT=${REPORT}
+          ${EXECUTABLE}
+          WORKING_DIRECTORY ${WORKING_DIR}
+          INPUT_FILE ${BENCH_STDIN}
+          OUTPUT_FILE ${BENCH_OUTPUT_DIR}/${SCENE}.log
+          ERROR_FILE ${BENCH_OUTPUT_DIR}/${SCENE}.log
+          TIMEOUT 300
+          RESULT_VARIABLE RESULT
+  )
+
+  # Scenes that do not go through WindowManager (01_Window) never produce a report.
+  if(EXISTS ${REPORT})
+    file(READ ${REPORT} CONTENT)
+    string(STRIP "${CONTENT}" CONTENT)
+    if(SCENES_JSON)
+      string(APPEND SCENES_JSON ",\n")
+    endif()
+    string(APPEND SCENES_JSON "${CONTENT}")
+  else()
+    list(APPEND FAILED ${SCENE})
+    message(WARNING "bench_frames: ${SCENE} produced no report (exit: ${RESULT}), see ${SCENE}.log")
+  endif()
+endforeach()
+
+set(FAILED_JSON "")
+foreach(SCENE ${FAILED})
+  if(FAILED_JSON)
+    string(APPEND FAILED_JSON ", ")
+  endif()
+  string(APPEND FAILED_JSON "\"${SCENE}\"")
+endforeach()
+
+file(WRITE ${BENCH_OUTPUT_DIR}/bench_frames.json
+        "{\n\"frames\": ${BENCH_FRAMES},\n\"warmup\": ${BENCH_WARMUP},\n\"failed\": [${FAILED_JSON}],\n\"scenes\": [\n${SCENES_JSON}\n]\n}\n")
+message(STATUS "bench_frames: report written to ${BENCH_OUTPUT_DIR}/bench_frames.json")
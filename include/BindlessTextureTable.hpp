@@ -0,0 +1,64 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "Texture.hpp"
+#include "TextureArray.hpp"
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// Resident ARB_bindless_texture handles in a shader storage buffer, read in GLSL as
+//     layout(std430, binding = N) readonly buffer TextureHandles { uvec2 handles[]; };
+//     texture(sampler2D(handles[slot]), uv)
+// with the slot taken from vertex or instance data. Any number of textures can be used by one draw, none
+// of them bound to a unit. Needs GL 4.3 for the storage buffer plus the extension; check isSupported()
+// and fall back to a TextureArray otherwise. The extension only defines sampling through a handle that is
+// the same for every invocation of a draw (dynamically uniform); a slot that varies per vertex or fragment,
+// as with SpriteBatch, also needs GL_NV_gpu_shader5 in the shader (see hasDivergentHandles()).
+//
+// Taking a handle freezes the texture's sampling parameters, and the handle dies with the texture object:
+// add textures after their final upload (Texture recreates its object when re-uploaded at another size).
+class BindlessTextureTable {
+private:
+    GLuint m_buffer {};
+    GLsizeiptr m_bufferSize {};
+    std::vector<GLuint64> m_handles;
+    std::unordered_map<GLuint, std::uint32_t> m_slots; // Texture name to slot.
+    bool m_dirty {};
+
+    void upload();
+
+public:
+    BindlessTextureTable();
+    // Makes every handle non-resident again.
+    ~BindlessTextureTable();
+
+    BindlessTextureTable(const BindlessTextureTable&) = delete;
+    BindlessTextureTable& operator=(const BindlessTextureTable&) = delete;
+
+    [[nodiscard]] static bool isSupported();
+    // GL_NV_gpu_shader5, which lifts the dynamically uniform requirement on handles.
+    [[nodiscard]] static bool hasDivergentHandles();
+
+    // Slot of the texture's handle, made resident on first use; adding a texture again returns its slot.
+    // Empty, after printing why, without bindless textures or when the driver gives no handle.
+    std::optional<std::uint32_t> add(GLuint texture);
+    std::optional<std::uint32_t> add(const Texture& texture) {
+        return add(texture.getID());
+    }
+    // For sampler2DArray handles.
+    std::optional<std::uint32_t> add(const TextureArray& textureArray) {
+        return add(textureArray.getID());
+    }
+
+    // Uploads the handles added since the last call and binds the buffer to the storage binding point.
+    void bind(GLuint bindingPoint);
+
+    [[nodiscard]] GLuint getBufferID() const {
+        return m_buffer;
+    }
+    [[nodiscard]] std::size_t size() const {
+        return m_handles.size();
+    }
+};
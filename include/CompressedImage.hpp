@@ -0,0 +1,59 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "MipChain.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pre-compressed texture blocks (BC1-BC7, ETC2/EAC) read from a KTX2 or DDS file, every mip level
+// stored in the file kept as is for glCompressedTexImage2D. Loading does no GL calls, so it can run on
+// TextureLoader's workers; whether the context takes the format is checked when the texture is uploaded.
+// Only plain 2D images are read: no arrays, cube maps or KTX2 supercompression (Basis, Zstd).
+// Rows are uploaded as stored, so like the stb_image path they must run bottom to top; texture_compress
+// writes them that way, files from other tools may need flipped texture coordinates.
+class CompressedImage {
+public:
+    using Level = MipChain::Level;
+
+private:
+    std::vector<GLubyte> m_data;
+    std::vector<Level> m_levels;
+    GLenum m_internalFormat {};
+
+    bool parseKTX2(const std::vector<GLubyte>& file, const std::string& path);
+    bool parseDDS(const std::vector<GLubyte>& file, const std::string& path);
+
+public:
+    CompressedImage() = default;
+    // Levels must be ordered from level 0 down and sized for internalFormat's blocks.
+    CompressedImage(GLenum internalFormat, std::vector<GLubyte> data, std::vector<Level> levels);
+
+    // Empty on failure, after printing why.
+    static CompressedImage load(const std::string& path);
+    // .ktx2 and .dds, the files load() reads.
+    [[nodiscard]] static bool isCompressedPath(const std::string& path);
+
+    bool writeKTX2(const std::string& path) const;
+
+    // Bytes of one 4x4 block, 0 for formats this class does not know.
+    [[nodiscard]] static GLsizei blockBytes(GLenum internalFormat);
+    // Size of one level of a width x height image, rounded up to whole blocks.
+    [[nodiscard]] static std::size_t levelBytes(GLenum internalFormat, GLsizei width, GLsizei height);
+
+    [[nodiscard]] const GLubyte* getData() const {
+        return m_data.data();
+    }
+    [[nodiscard]] std::size_t getSize() const {
+        return m_data.size();
+    }
+    [[nodiscard]] const std::vector<Level>& getLevels() const {
+        return m_levels;
+    }
+    [[nodiscard]] GLenum getInternalFormat() const {
+        return m_internalFormat;
+    }
+    [[nodiscard]] bool empty() const {
+        return m_levels.empty();
+    }
+};
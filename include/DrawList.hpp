@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "MeshArena.hpp"
+#include "StreamBuffer.hpp"
+#include "glad/glad.h"
+
+// Draws of meshes from one MeshArena, recorded on the CPU and submitted together. On GL 4.3 the commands
+// are streamed into a GL_DRAW_INDIRECT_BUFFER and the whole list is one glMultiDrawElementsIndirect, so
+// thousands of draws cost one call and one VAO bind.
+//
+// Per-draw data (transforms, colors, material indices) goes in per-instance attributes: each command's base
+// instance is where its instances start reading, so a draw with n instances reads records b .. b + n - 1,
+// where b is the index returned by the first add(). That works in GLSL 330 shaders, unlike gl_DrawID, which
+// needs GLSL 460.
+//
+// Before 4.3 submit() loops over the commands with glDrawElementsInstancedBaseVertexBaseInstance. Before 4.2
+// no draw call takes a base instance, so every draw would read record 0: the list refuses to record anything
+// there (see isSupported()).
+class DrawList {
+public:
+    // Layout glMultiDrawElementsIndirect reads.
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+private:
+    std::size_t m_capacity {};
+    std::vector<DrawElementsIndirectCommand> m_commands;
+    GLuint m_instanceCount {};
+    std::unique_ptr<StreamBuffer> m_indirect; // Only with glMultiDrawElementsIndirect (GL 4.3).
+    std::uint32_t m_drawCalls {};
+
+public:
+    // capacity: commands all the submits of one frame can put in the indirect buffer. A list that no longer
+    // fits is still drawn, with one call per command.
+    explicit DrawList(std::size_t capacity);
+
+    // Whether the context can honour base instances (GL 4.2). Without it add() records nothing.
+    [[nodiscard]] static bool isSupported();
+
+    // Records instanceCount instances of mesh and returns the first per-instance record they read.
+    GLuint add(const MeshArena::Mesh& mesh, GLuint instanceCount = 1);
+    // Same, reading per-instance records from baseInstance on, for data not laid out in add() order.
+    void add(const MeshArena::Mesh& mesh, GLuint instanceCount, GLuint baseInstance);
+    void clear();
+
+    // Draws every recorded command with the arena's VAO and whatever program is in use. The list is kept;
+    // clear() it before recording the next frame.
+    void submit(const MeshArena& arena, GLenum mode = GL_TRIANGLES);
+    // Retires this frame's indirect buffer region. Call once per frame, after the last submit().
+    void endFrame();
+
+    [[nodiscard]] std::size_t size() const {
+        return m_commands.size();
+    }
+    // Instance records the add() calls without a base instance have handed out.
+    [[nodiscard]] GLuint getInstanceCount() const {
+        return m_instanceCount;
+    }
+    // GL draw calls issued by the submits since the last endFrame().
+    [[nodiscard]] std::uint32_t getDrawCalls() const {
+        return m_drawCalls;
+    }
+    [[nodiscard]] bool isMultiDrawIndirect() const {
+        return m_indirect != nullptr;
+    }
+};
@@ -9,10 +9,42 @@
 class EBO {
 private:
     GLuint m_ID;
+    GLenum m_indexType { GL_UNSIGNED_INT };
+    GLsizei m_count {};
+
+    void create(const void* indices, GLsizeiptr size);
 public:
+    // Written between strips or fans in a 32-bit index list, it ends one primitive and starts the next when
+    // primitive restart is on (GLStateCache::setPrimitiveRestart). It is the largest value of the type, so it
+    // stays a restart marker when the indices are narrowed.
+    static constexpr GLuint RESTART_INDEX { 0xFFFFFFFF };
+
+    // 32-bit indices whose largest value fits in 16 bits are stored as GL_UNSIGNED_SHORT, halving the
+    // index bandwidth; draw with getIndexType() rather than assuming GL_UNSIGNED_INT.
     EBO(const GLuint* indices, GLsizeiptr size);
+    // Stored as given. 8-bit indices are left to the caller because much hardware widens them on the fly.
+    EBO(const GLushort* indices, GLsizeiptr size);
+    EBO(const GLubyte* indices, GLsizeiptr size);
     ~EBO();
 
+    EBO(const EBO&) = delete;
+    EBO& operator=(const EBO&) = delete;
+
     void bind() const;
     static void unbind();
-};
\ No newline at end of file
+
+    [[nodiscard]] GLuint getID() const {
+        return m_ID;
+    }
+    // GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, as glDrawElements expects it.
+    [[nodiscard]] GLenum getIndexType() const {
+        return m_indexType;
+    }
+    [[nodiscard]] GLsizei getCount() const {
+        return m_count;
+    }
+
+    static GLsizei indexSize(GLenum indexType);
+    // Largest value of the type, the one GL_PRIMITIVE_RESTART_FIXED_INDEX restarts on.
+    static GLuint restartIndex(GLenum indexType);
+};
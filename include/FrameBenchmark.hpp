@@ -0,0 +1,69 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Per-frame measurements for the bench_frames target. Enabled by WindowManager when COREGL_BENCH_OUTPUT
+// names a report file; COREGL_BENCH_FRAMES and COREGL_BENCH_WARMUP set how many frames are measured/skipped.
+// CPU time is measured between frame boundaries, GPU time with GL_TIME_ELAPSED queries that are read back
+// a few frames late so the pipeline never stalls, and draw/state/uniform calls by wrapping glad's pointers.
+class FrameBenchmark {
+private:
+    static constexpr std::size_t QUERY_RING_SIZE { 8 };
+
+    struct FrameCounters {
+        std::uint64_t drawCalls {};
+        std::uint64_t stateChanges {};
+        std::uint64_t uniformUpdates {};
+    };
+
+    std::string m_scene;
+    std::string m_outputPath;
+    long long m_warmupFrames {};
+    long long m_measuredFrames {};
+    long long m_frameIndex {};
+    bool m_reportWritten {};
+
+    std::chrono::steady_clock::time_point m_frameStart {};
+    std::vector<double> m_cpuFrameMs;
+    std::vector<double> m_gpuFrameMs;
+    std::vector<FrameCounters> m_counters;
+
+    std::array<GLuint, QUERY_RING_SIZE> m_queries {};
+    std::array<long long, QUERY_RING_SIZE> m_queryFrame {};
+    std::size_t m_queryHead {};
+    std::size_t m_queriesPending {};
+    bool m_queryActive {};
+
+    void collectQueries(bool wait);
+
+public:
+    FrameBenchmark(std::string scene, std::string outputPath, long long warmupFrames, long long measuredFrames);
+    ~FrameBenchmark();
+
+    FrameBenchmark(const FrameBenchmark&) = delete;
+    FrameBenchmark& operator=(const FrameBenchmark&) = delete;
+
+    // Reads the COREGL_BENCH_* environment; returns nullptr when benchmarking was not requested.
+    static std::unique_ptr<FrameBenchmark> createFromEnvironment(const char* fallbackScene);
+
+    // Total frames the scene has to run (warm-up plus measured).
+    [[nodiscard]] long long getFrameBudget() const {
+        return m_warmupFrames + m_measuredFrames;
+    }
+    [[nodiscard]] bool isFinished() const {
+        return m_reportWritten;
+    }
+
+    // Call right before presenting: closes the GPU query of the current frame.
+    void endFrame();
+    // Call right after presenting: records the CPU frame time and opens the next frame.
+    void beginFrame();
+    // Drains outstanding queries and writes the JSON report. Only the first call has any effect.
+    void writeReport();
+};
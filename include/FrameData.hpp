@@ -0,0 +1,30 @@
+#pragma once
+
+#include "UniformBuffer.hpp"
+
+// Values every program may need once per frame. Written to a UniformBuffer at FRAME_DATA_BINDING once a
+// frame; shaders read them by declaring the same block:
+//
+//     layout(std140) uniform FrameData {
+//         mat4 projection;
+//         mat4 view;
+//         vec2 resolution;
+//         float time;
+//         float deltaTime;
+//     };
+struct FrameData {
+    glm::mat4 projection { 1.0f };
+    glm::mat4 view { 1.0f };
+    glm::vec2 resolution {};
+    float time {};
+    float deltaTime {};
+};
+
+STD140_CHECK_MEMBER(FrameData, projection);
+STD140_CHECK_MEMBER(FrameData, view);
+STD140_CHECK_MEMBER(FrameData, resolution);
+STD140_CHECK_MEMBER(FrameData, time);
+STD140_CHECK_MEMBER(FrameData, deltaTime);
+STD140_CHECK_BLOCK(FrameData);
+
+constexpr GLuint FRAME_DATA_BINDING { 0 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Frame timing for WindowManager. Time is kept as integer nanoseconds from steady_clock, so it stays exact
+// however long the program runs (a float from glfwGetTime() is down to ~0.25 ms steps after a day).
+// Simulation can advance in fixed steps, decoupled from rendering:
+//
+//     while (scheduler.stepFixedUpdate()) { update(scheduler.getFixedStepSeconds()); }
+//     render(scheduler.getInterpolationAlpha());
+//
+// With a target frame rate set, waitForNextFrame() sleeps most of the remaining time and spins the
+// last stretch, which holds the frame time steady without keeping a core busy.
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Nanoseconds = std::chrono::nanoseconds;
+
+private:
+    Clock::time_point m_startTime {};
+    Clock::time_point m_frameStart {};
+    bool m_started {};
+
+    Nanoseconds m_delta {};
+    double m_smoothedDeltaSeconds {};
+    double m_smoothingFactor { 0.1 }; // Weight of the newest frame in the moving average.
+
+    Nanoseconds m_fixedStep { Nanoseconds(std::chrono::seconds(1)) / 60 };
+    Nanoseconds m_accumulator {};
+    int m_maxStepsPerFrame { 8 };
+    int m_stepsThisFrame {};
+
+    Nanoseconds m_targetFrameTime {};                     // Zero: no cap.
+    Nanoseconds m_spinTime { std::chrono::milliseconds(2) }; // Covers the OS sleep granularity.
+
+public:
+    // Call at the start of every frame. The first call reports a delta of zero.
+    void beginFrame();
+    // Consumes one fixed step from the accumulator. Steps beyond maxStepsPerFrame are dropped so a long
+    // stall (breakpoint, window drag) cannot snowball into ever longer frames.
+    bool stepFixedUpdate();
+    // Blocks until the target frame time has passed since beginFrame(). Returns at once without a cap.
+    void waitForNextFrame() const;
+
+    void setFixedStep(Nanoseconds step);
+    void setMaxStepsPerFrame(int steps);
+    // 0 removes the cap.
+    void setTargetFrameRate(double framesPerSecond);
+    void setSpinTime(Nanoseconds spinTime);
+    // alpha in (0, 1]; lower values smooth more.
+    void setSmoothingFactor(double alpha);
+
+    [[nodiscard]] Nanoseconds getDelta() const {
+        return m_delta;
+    }
+    [[nodiscard]] double getDeltaSeconds() const {
+        return std::chrono::duration<double>(m_delta).count();
+    }
+    // Exponential moving average of the frame time, for display and for adapting quality settings.
+    [[nodiscard]] double getSmoothedDeltaSeconds() const {
+        return m_smoothedDeltaSeconds;
+    }
+    [[nodiscard]] double getFixedStepSeconds() const {
+        return std::chrono::duration<double>(m_fixedStep).count();
+    }
+    // How far rendering is between the last two fixed steps, for interpolating simulated state.
+    [[nodiscard]] double getInterpolationAlpha() const {
+        return static_cast<double>(m_accumulator.count()) / static_cast<double>(m_fixedStep.count());
+    }
+    // Time since the first frame, at the start of the current frame.
+    [[nodiscard]] Nanoseconds getElapsed() const {
+        return m_frameStart - m_startTime;
+    }
+    [[nodiscard]] double getElapsedSeconds() const {
+        return std::chrono::duration<double>(getElapsed()).count();
+    }
+};
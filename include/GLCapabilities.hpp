@@ -0,0 +1,75 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstdint>
+#include <string_view>
+#include <unordered_set>
+
+// KHR_parallel_shader_compile / ARB_parallel_shader_compile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+
+// EXT_texture_compression_s3tc (BC1-BC3) and its sRGB variants
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT 0x8C4E
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+// Extensions glad was not generated with. The extension list and the few entry points used from them
+// are fetched once per context, right after glad has been loaded.
+class GLCapabilities {
+private:
+    using MaxShaderCompilerThreadsProc = void (APIENTRYP)(GLuint count);
+    using GetTextureHandleProc = GLuint64 (APIENTRYP)(GLuint texture);
+    using TextureHandleProc = void (APIENTRYP)(GLuint64 handle);
+
+    static std::unordered_set<std::uint64_t> s_extensions; // Hashed names, see Hash.hpp.
+    static MaxShaderCompilerThreadsProc s_maxShaderCompilerThreads;
+    static GetTextureHandleProc s_getTextureHandle;
+    static TextureHandleProc s_makeTextureHandleResident;
+    static TextureHandleProc s_makeTextureHandleNonResident;
+    static bool s_directStateAccess;
+
+public:
+    static void load(GLADloadproc loader);
+
+    [[nodiscard]] static bool hasExtension(std::string_view name);
+
+    // Programs compile on driver threads; GL_COMPLETION_STATUS_KHR can be polled without blocking.
+    [[nodiscard]] static bool hasParallelShaderCompile();
+    // 0xFFFFFFFF lets the driver pick. Does nothing without parallel shader compile.
+    static void setMaxShaderCompilerThreads(GLuint count);
+
+    // Whether glCompressedTexImage2D takes this internal format: S3TC needs the extension, RGTC is core
+    // since 3.0, BPTC since 4.2 and ETC2/EAC since 4.3 (often decoded by the driver on desktop GPUs).
+    [[nodiscard]] static bool hasCompressedFormat(GLenum internalFormat);
+
+    // ARB_bindless_texture: a texture becomes a 64-bit handle that shaders turn back into a sampler, so
+    // no texture unit is involved. Handles must be made resident before a draw uses them.
+    [[nodiscard]] static bool hasBindlessTexture() {
+        return s_getTextureHandle != nullptr;
+    }
+    // Handle of the texture with its current sampling parameters, which can no longer change afterwards.
+    // 0 without bindless textures.
+    [[nodiscard]] static GLuint64 getTextureHandle(GLuint texture);
+    static void makeTextureHandleResident(GLuint64 handle);
+    static void makeTextureHandleNonResident(GLuint64 handle);
+
+    // GL 4.5 direct state access: objects are created and edited by name, without binding them.
+    // COREGL_NO_DSA=1 forces the bind-to-edit path, to test what GL 3.3 machines run.
+    [[nodiscard]] static bool hasDirectStateAccess() {
+        return s_directStateAccess;
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <array>
+#include <cstdint>
+
+// Shadow copy of the GL binding state that drops calls which would not change anything.
+// The wrappers (VAO, VBO, EBO, StreamBuffer, Texture, Shader) go through it; code that calls GL directly
+// behind its back (raw exercises, third-party renderers that do not restore state) must call invalidate()
+// afterwards. The element buffer binding belongs to the VAO, so it is forgotten whenever the VAO changes.
+// One cache for the one context the exercises use; WindowManager invalidates it when a context is created.
+class GLStateCache {
+public:
+    enum class Kind {
+        Program,
+        VertexArray,
+        Buffer,
+        ActiveTexture,
+        Texture,
+        Blend,
+        PolygonMode,
+        Viewport,
+        PrimitiveRestart,
+        Count
+    };
+
+    struct Counters {
+        std::array<std::uint64_t, static_cast<std::size_t>(Kind::Count)> issued {};
+        std::array<std::uint64_t, static_cast<std::size_t>(Kind::Count)> skipped {};
+
+        [[nodiscard]] std::uint64_t totalIssued() const;
+        [[nodiscard]] std::uint64_t totalSkipped() const;
+    };
+
+    static constexpr GLuint UNKNOWN { 0xFFFFFFFF };
+    static constexpr int MAX_TEXTURE_UNITS { 32 };
+
+private:
+    static constexpr int BUFFER_TARGET_COUNT { 10 };
+    static constexpr int TEXTURE_TARGET_COUNT { 5 };
+    static constexpr int INDEXED_TARGET_COUNT { 2 }; // Uniform and shader storage buffers.
+    static constexpr int MAX_INDEXED_BINDINGS { 16 };
+
+    struct State {
+        GLuint program { UNKNOWN };
+        GLuint vertexArray { UNKNOWN };
+        std::array<GLuint, BUFFER_TARGET_COUNT> buffers {};
+        std::array<std::array<GLuint, MAX_INDEXED_BINDINGS>, INDEXED_TARGET_COUNT> indexedBuffers {};
+        GLenum activeTexture { UNKNOWN };
+        std::array<std::array<GLuint, TEXTURE_TARGET_COUNT>, MAX_TEXTURE_UNITS> textures {};
+        GLint blend { -1 }; // -1 unknown, else GL_TRUE/GL_FALSE
+        std::array<GLenum, 4> blendFunc {}; // Source RGB, destination RGB, source alpha, destination alpha.
+        GLenum polygonMode { UNKNOWN };
+        std::array<GLint, 4> viewport {};
+        bool viewportKnown {};
+        GLint primitiveRestart { -1 };
+        std::int64_t restartIndex { -1 }; // Only used before GL 4.3, -1 unknown.
+    };
+
+    static State s_state;
+    static Counters s_counters;
+
+    static State makeUnknownState();
+
+    static int bufferTargetIndex(GLenum target);
+    static int textureTargetIndex(GLenum target);
+    static int indexedTargetIndex(GLenum target);
+    // Counts the call and returns whether it has to be issued.
+    static bool changes(Kind kind, bool differs);
+
+public:
+    // Forgets everything; the next call of every kind is issued.
+    static void invalidate();
+
+    static void useProgram(GLuint program);
+    static void bindVertexArray(GLuint vertexArray);
+    static void bindBuffer(GLenum target, GLuint buffer);
+    // glBindBufferBase for GL_UNIFORM_BUFFER / GL_SHADER_STORAGE_BUFFER binding points. Like GL, it also
+    // leaves the buffer bound to the target itself.
+    static void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    static void activeTexture(GLenum unit);
+    // Binds to the given unit (GL_TEXTURE0 + n), switching the active unit only if needed.
+    static void bindTexture(GLenum unit, GLenum target, GLuint texture);
+    // Binds to whichever unit is active, e.g. to edit a texture's parameters.
+    static void bindTexture(GLenum target, GLuint texture);
+
+    static void setBlend(bool enabled);
+    static void setBlendFunc(GLenum source, GLenum destination);
+    static void setBlendFuncSeparate(GLenum sourceRGB, GLenum destinationRGB, GLenum sourceAlpha,
+                                     GLenum destinationAlpha);
+    // Always GL_FRONT_AND_BACK, the only face core profiles accept.
+    static void setPolygonMode(GLenum mode);
+    static void setViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    // Restarts strips and fans at EBO::restartIndex(indexType). GL 4.3 does that for every index type at once
+    // (GL_PRIMITIVE_RESTART_FIXED_INDEX); before it the index is set for the type given here, so call this
+    // again when drawing with another index type.
+    static void setPrimitiveRestart(bool enabled, GLenum indexType = GL_UNSIGNED_INT);
+
+    // Deleting an object unbinds it in GL; these keep the cache in step. The wrappers call them.
+    static void onProgramDeleted(GLuint program);
+    static void onVertexArrayDeleted(GLuint vertexArray);
+    static void onBufferDeleted(GLuint buffer);
+    static void onTextureDeleted(GLuint texture);
+    // glVertexArrayElementBuffer edits a VAO without binding it; this matters if it is the bound one.
+    static void onElementBufferChanged(GLuint vertexArray, GLuint buffer);
+
+    [[nodiscard]] static GLuint getProgram() {
+        return s_state.program;
+    }
+    [[nodiscard]] static GLuint getVertexArray() {
+        return s_state.vertexArray;
+    }
+    [[nodiscard]] static const Counters& getCounters() {
+        return s_counters;
+    }
+    static void resetCounters();
+};
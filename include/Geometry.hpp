@@ -0,0 +1,91 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Procedural 2D shapes written straight into memory the caller owns: a std::vector sized from the
+// matching *Counts() call, or a mapped buffer (StreamBuffer::allocate). Nothing here allocates except Batch.
+// Rim points come from arc(), which rotates blocks of points instead of calling cos/sin per vertex,
+// so shapes with hundreds of thousands of sides are cheap to rebuild.
+namespace Geometry {
+    // How indices are emitted. Triangles works with any shape and can be mixed freely in one draw;
+    // Fan (polygons, circles, rounded rects) and Strip (rings) use fewer indices, and several of them can
+    // share one draw through primitive restart, with EBO::RESTART_INDEX written between them (see Batch).
+    enum class Topology {
+        Triangles,
+        Fan,
+        Strip
+    };
+
+    // Where a shape goes. Vertices are x, y pairs stride floats apart, so they can sit inside an
+    // interleaved layout; only the position is written.
+    struct Target {
+        GLfloat* positions {};
+        std::size_t stride { 2 };
+        GLuint* indices {};    // nullptr to write vertices only.
+        GLuint baseVertex {};  // Added to every index, for several shapes in one vertex buffer.
+    };
+
+    struct Counts {
+        std::size_t vertices {};
+        std::size_t indices {};
+    };
+
+    // count points on a circle, the i-th at angle startAngle + i * step (radians, counterclockwise).
+    void arc(GLfloat* positions, std::size_t stride, std::size_t count, glm::vec2 center, float radius,
+             float startAngle, float step);
+
+    // Regular polygon: a center vertex followed by the rim, first rim point at startAngle.
+    // Triangles or Fan; anything else writes nothing and returns {}.
+    Counts polygonCounts(int sides, Topology topology = Topology::Triangles);
+    Counts polygon(const Target& target, int sides, glm::vec2 center, float radius,
+                   Topology topology = Topology::Triangles, float startAngle = 0.0f);
+
+    // Fewest polygon sides whose edges stay within maxError (same unit as radius) of the true circle.
+    int circleSides(float radius, float maxError);
+
+    // Band between two circles; vertices alternate outer, inner. Triangles or Strip.
+    Counts ringCounts(int segments, Topology topology = Topology::Triangles);
+    Counts ring(const Target& target, int segments, glm::vec2 center, float innerRadius, float outerRadius,
+                Topology topology = Topology::Triangles);
+
+    // Rectangle of the given full size with quarter circle corners of cornerSegments (at least 1) edges;
+    // the radius is clamped to half the shorter side. Drawn like a polygon: center vertex plus rim,
+    // Triangles or Fan.
+    Counts roundedRectCounts(int cornerSegments, Topology topology = Topology::Triangles);
+    Counts roundedRect(const Target& target, glm::vec2 center, glm::vec2 size, float cornerRadius, int cornerSegments,
+                       Topology topology = Topology::Triangles);
+
+    // Many shapes of one topology in one vertex and index list, drawn with a single call. Fans and strips are
+    // joined with EBO::RESTART_INDEX, so enable restart for the draw (GLStateCache::setPrimitiveRestart with
+    // the EBO's index type); Triangles lists need no marker.
+    class Batch {
+    private:
+        Topology m_topology;
+        std::size_t m_stride;
+        std::vector<GLfloat> m_positions;
+        std::vector<GLuint> m_indices;
+
+    public:
+        explicit Batch(Topology topology, std::size_t stride = 2);
+
+        // Room for one more shape of the given counts, made with the batch's topology: pass the result straight
+        // to polygon(), ring() or roundedRect(). Valid until the next add().
+        Target add(Counts counts);
+        void clear();
+
+        // GL_TRIANGLES, GL_TRIANGLE_FAN or GL_TRIANGLE_STRIP, for the draw call.
+        [[nodiscard]] GLenum getPrimitiveMode() const;
+        [[nodiscard]] Topology getTopology() const {
+            return m_topology;
+        }
+        [[nodiscard]] const std::vector<GLfloat>& getPositions() const {
+            return m_positions;
+        }
+        [[nodiscard]] const std::vector<GLuint>& getIndices() const {
+            return m_indices;
+        }
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// 64-bit FNV-1a. constexpr so names known at compile time (uniform names, cache tags) hash for free.
+constexpr std::uint64_t FNV1A_OFFSET_BASIS { 0xcbf29ce484222325ull };
+constexpr std::uint64_t FNV1A_PRIME { 0x100000001b3ull };
+
+constexpr std::uint64_t fnv1a64(const std::string_view text, std::uint64_t hash = FNV1A_OFFSET_BASIS) {
+    for (const char c : text) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= FNV1A_PRIME;
+    }
+    return hash;
+}
+
+inline std::uint64_t fnv1a64(const void* data, const std::size_t size, std::uint64_t hash = FNV1A_OFFSET_BASIS) {
+    const auto* bytes { static_cast<const std::uint8_t*>(data) };
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV1A_PRIME;
+    }
+    return hash;
+}
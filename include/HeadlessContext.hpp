@@ -0,0 +1,43 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <vector>
+
+// Off-screen OpenGL context for machines without a display (CI, render farm nodes).
+// The context comes from EGL (Mesa surfaceless, EGL device or pbuffer, in that order of preference)
+// and everything is drawn into an FBO that stays bound as the default framebuffer.
+class HeadlessContext {
+private:
+    void* m_display {};
+    void* m_context {};
+    void* m_surface {};
+
+    GLuint m_FBO {};
+    GLuint m_colorRBO {};
+    GLuint m_depthRBO {};
+    int m_width {};
+    int m_height {};
+
+public:
+    HeadlessContext() = default;
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    static bool isAvailable();
+    static void* getProcAddress(const char* name);
+
+    // Creates the context and makes it current. Returns false when no EGL implementation could provide one.
+    bool create(int width, int height, int versionMajor, int versionMinor);
+    // Builds the render target. Needs the GL function pointers, so call it after glad has been loaded.
+    bool createFramebuffer();
+    void destroy();
+
+    [[nodiscard]] GLuint getFramebuffer() const {
+        return m_FBO;
+    }
+
+    // Reads back the color attachment as tightly packed RGBA8, bottom row first.
+    void readPixels(std::vector<GLubyte>& pixels) const;
+};
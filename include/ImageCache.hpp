@@ -0,0 +1,36 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "MipChain.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// On-disk cache of decoded images with their mip chains, so a warm start reads pixels instead of
+// running the PNG/JPEG decoder and the mip filter again. Entries are keyed by the source file's contents
+// (not its name or mtime), so an edited image misses and identical files share one entry. An entry is a
+// small header followed by the raw chain; it is memory mapped and the returned MipChain points into the
+// mapping, which goes to the pixel unpack buffer or glTexSubImage2D without another copy.
+// The directory comes from COREGL_IMAGE_CACHE_DIR, or "image_cache" next to the working directory;
+// setting it to an empty string turns the cache off.
+class ImageCache {
+private:
+    static std::filesystem::path entryPath(std::uint64_t key);
+
+public:
+    static void setDirectory(const std::filesystem::path& directory);
+    [[nodiscard]] static const std::filesystem::path& getDirectory();
+    [[nodiscard]] static bool isEnabled();
+
+    // Hash of the encoded file plus everything that changes the decoded result.
+    [[nodiscard]] static std::uint64_t makeKey(const void* fileData, std::size_t fileSize, int desiredChannels);
+
+    // Mapped chain, or an empty one if there is no valid entry.
+    [[nodiscard]] static MipChain load(std::uint64_t key);
+    static void store(std::uint64_t key, const MipChain& mips);
+
+    // What Texture and TextureLoader use: the file's chain from the cache, or decoded with stb_image (rows
+    // flipped bottom to top), filtered like Texture does and stored. desiredChannels = 0 keeps the file's
+    // channel count. Empty if the file cannot be read. Thread safe.
+    [[nodiscard]] static MipChain decode(const std::string& path, int desiredChannels = 0);
+};
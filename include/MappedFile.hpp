@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Read-only memory mapping of a whole file. Pages are read in by the OS as they are touched, so handing
+// the bytes to memcpy or glTexSubImage2D reads them straight from the page cache without a buffered copy.
+class MappedFile {
+private:
+    const std::uint8_t* m_data {};
+    std::size_t m_size {};
+#ifdef _WIN32
+    void* m_mapping {};
+#endif
+
+    void close();
+
+public:
+    MappedFile() = default;
+    // Empty (check empty()) if the file cannot be opened or mapped, or has no bytes.
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] const std::uint8_t* getData() const {
+        return m_data;
+    }
+    [[nodiscard]] std::size_t getSize() const {
+        return m_size;
+    }
+    [[nodiscard]] bool empty() const {
+        return m_size == 0;
+    }
+};
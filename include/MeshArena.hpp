@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "VAO.hpp"
+#include "VBO.hpp"
+#include "EBO.hpp"
+#include "glad/glad.h"
+
+// Many small meshes with the same vertex layout packed into one VBO and one EBO behind one VAO, so they can
+// all be drawn without rebinding anything (see DrawList). Meshes are added on the CPU, then build() uploads
+// them once. Indices stay relative to their own mesh and are offset at draw time by the base vertex, which
+// keeps them small: the EBO narrows them to 16 bits as long as every mesh has fewer than 65535 vertices.
+class MeshArena {
+public:
+    // Where a mesh lives in the arena, in indices and vertices, as a DrawElementsIndirectCommand wants it.
+    struct Mesh {
+        GLuint firstIndex {};
+        GLuint indexCount {};
+        GLint baseVertex {};
+    };
+
+private:
+    GLsizei m_stride {};
+    std::vector<GLubyte> m_vertices;
+    std::vector<GLuint> m_indices;
+    std::unique_ptr<VBO> m_VBO;
+    std::unique_ptr<EBO> m_EBO;
+    VAO m_VAO;
+
+public:
+    // stride: bytes per vertex, the same for every mesh.
+    explicit MeshArena(GLsizei stride);
+
+    // indices count from 0 for the mesh's own first vertex. Only before build().
+    Mesh add(const void* vertices, GLsizei vertexCount, const GLuint* indices, GLsizei indexCount);
+    // Same for a triangle list of float vertices, position first: MeshOptimizer::optimize reorders it for the
+    // vertex cache, overdraw and fetches before it goes in, and the report is logged. Give positionComponents 2
+    // for flat meshes, which skips the overdraw pass.
+    Mesh addOptimized(std::vector<GLfloat> vertices, std::vector<GLuint> indices, std::size_t positionComponents = 3);
+    // Uploads everything added and attaches the index buffer to the VAO. Link the vertex attributes
+    // against getVBO() afterwards; per-draw attributes from other buffers go on the same VAO.
+    void build();
+
+    [[nodiscard]] bool isBuilt() const {
+        return m_EBO != nullptr;
+    }
+    [[nodiscard]] VAO& getVAO() {
+        return m_VAO;
+    }
+    [[nodiscard]] const VAO& getVAO() const {
+        return m_VAO;
+    }
+    [[nodiscard]] const VBO& getVBO() const {
+        return *m_VBO;
+    }
+    [[nodiscard]] GLenum getIndexType() const {
+        return m_EBO->getIndexType();
+    }
+    [[nodiscard]] GLsizei getStride() const {
+        return m_stride;
+    }
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// Reorders indexed triangle lists so the GPU does less work for the same picture:
+//   optimizeVertexCache  Tipsify (Sander, Nehab, Barczak 2007): triangles are emitted in fans around
+//                        vertices that are still in the post-transform cache, so fewer vertices are shaded twice.
+//   optimizeOverdraw     splits the cache-ordered list into clusters and draws the outward facing ones first,
+//                        so the depth test rejects more of what lies behind them. Costs at most `threshold`
+//                        times the cluster's cache efficiency.
+//   optimizeVertexFetch  renumbers vertices in the order they are first used, so vertex fetches walk memory
+//                        forward; unreferenced vertices are dropped.
+// Run them in that order, on load or from an offline tool, before the data goes into a VBO/EBO pair.
+// Passes that write to destination accept destination == indices.
+namespace MeshOptimizer {
+    // Post-transform cache entries assumed by the FIFO model; small enough to pay off on any GPU.
+    constexpr std::size_t DEFAULT_CACHE_SIZE { 16 };
+    constexpr GLuint NO_VERTEX { 0xFFFFFFFF };
+
+    struct CacheStats {
+        std::size_t transforms {}; // Vertex shader invocations.
+        float acmr {};             // Transforms per triangle: 3 at worst, about 0.5 for a large grid.
+        float atvr {};             // Transforms per referenced vertex: 1 is ideal.
+    };
+
+    struct FetchStats {
+        std::size_t bytesFetched {}; // In 64 byte cache lines.
+        float overfetch {};          // bytesFetched over the size of the referenced vertices: 1 is ideal.
+    };
+
+    CacheStats analyzeVertexCache(const GLuint* indices, std::size_t indexCount, std::size_t vertexCount,
+                                  std::size_t cacheSize = DEFAULT_CACHE_SIZE);
+    FetchStats analyzeVertexFetch(const GLuint* indices, std::size_t indexCount, std::size_t vertexCount,
+                                  std::size_t vertexSize, std::size_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    void optimizeVertexCache(GLuint* destination, const GLuint* indices, std::size_t indexCount,
+                             std::size_t vertexCount, std::size_t cacheSize = DEFAULT_CACHE_SIZE);
+    // positions: x, y, z of each vertex, positionStride floats apart. indices should already be cache ordered.
+    void optimizeOverdraw(GLuint* destination, const GLuint* indices, std::size_t indexCount, const GLfloat* positions,
+                          std::size_t positionStride, std::size_t vertexCount, float threshold = 1.05f,
+                          std::size_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    // Fills remap[vertexCount] with each vertex's new position, NO_VERTEX for unused ones; returns how many are kept.
+    std::size_t optimizeVertexFetch(GLuint* remap, const GLuint* indices, std::size_t indexCount,
+                                    std::size_t vertexCount);
+    void remapIndices(GLuint* destination, const GLuint* indices, std::size_t indexCount, const GLuint* remap);
+    // destination holds the kept vertices only and must not overlap vertices.
+    void remapVertices(void* destination, const void* vertices, std::size_t vertexCount, std::size_t vertexSize,
+                       const GLuint* remap);
+
+    struct Report {
+        CacheStats cacheBefore;
+        CacheStats cacheAfter;
+        FetchStats fetchBefore;
+        FetchStats fetchAfter;
+    };
+
+    // All three passes on interleaved float vertices, position first. With fewer than 3 position components the
+    // mesh is flat, every triangle faces the same way and the overdraw pass is skipped.
+    Report optimize(std::vector<GLfloat>& vertices, std::size_t floatsPerVertex, std::vector<GLuint>& indices,
+                    std::size_t positionComponents = 3);
+
+    // "ACMR 1.50 -> 0.71, ATVR 2.10 -> 1.00, overfetch 1.80 -> 1.00"
+    std::ostream& operator<<(std::ostream& out, const Report& report);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class MappedFile;
+
+// Every mip level of an 8-bit image, built on the CPU so the texture can be uploaded level by level
+// instead of asking the driver for glGenerateMipmap. Levels are tightly packed one after the other,
+// level 0 first, so the whole chain can be copied into a pixel unpack buffer in one go.
+// A chain read back from ImageCache does not own its bytes: they stay in the mapped cache file.
+class MipChain {
+public:
+    struct Level {
+        GLsizei width {};
+        GLsizei height {};
+        std::size_t offset {}; // Bytes from the start of the chain.
+        std::size_t size {};
+    };
+
+private:
+    std::vector<GLubyte> m_data;
+    std::shared_ptr<const MappedFile> m_mapping;
+    const GLubyte* m_mappedData {}; // Inside m_mapping, when there is one.
+    std::size_t m_mappedSize {};
+    std::vector<Level> m_levels;
+    int m_numChannels {};
+
+public:
+    MipChain() = default;
+
+    // 2x2 box filter down to 1x1; odd edges repeat their last row or column. With srgb set the colour
+    // channels are averaged in linear light, which keeps distant texels from darkening; alpha and
+    // one or two channel images (masks, data) are averaged as stored. maxLevels > 0 stops the chain early.
+    // Thread safe.
+    static MipChain build(const GLubyte* pixels, GLsizei width, GLsizei height, int numChannels, bool srgb,
+                          GLsizei maxLevels = 0);
+
+    // Chain whose levels are size bytes at data, inside mapping; levels are laid out like build()'s.
+    static MipChain fromMapping(std::shared_ptr<const MappedFile> mapping, const GLubyte* data, std::size_t size,
+                                std::vector<Level> levels, int numChannels);
+
+    [[nodiscard]] const GLubyte* getData() const {
+        return m_mapping ? m_mappedData : m_data.data();
+    }
+    [[nodiscard]] std::size_t getSize() const {
+        return m_mapping ? m_mappedSize : m_data.size();
+    }
+    [[nodiscard]] bool isMapped() const {
+        return m_mapping != nullptr;
+    }
+    [[nodiscard]] const std::vector<Level>& getLevels() const {
+        return m_levels;
+    }
+    [[nodiscard]] int getNumChannels() const {
+        return m_numChannels;
+    }
+    [[nodiscard]] bool empty() const {
+        return m_levels.empty();
+    }
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// CPU and GPU timing per scope. Wrap passes or draws in a ProfileZone between beginFrame() and endFrame():
+//
+//     ProfileZone zone(profiler, "Sprites");
+//
+// GPU times come from GL_TIMESTAMP queries at both ends of every zone. Each frame writes its own query
+// pool and is read back FRAME_LATENCY frames later, once the results are available, so nothing ever waits
+// on the GPU; a frame whose queries are still not done by then keeps its CPU times only.
+// drawImGui() shows a timeline of one frame and a flame graph averaged over the history.
+// Setting COREGL_PROFILE_OUTPUT records every frame and writes a Chrome trace (chrome://tracing,
+// ui.perfetto.dev) there when the profiler is destroyed, which is how headless runs get a capture.
+class Profiler {
+public:
+    static constexpr std::size_t FRAME_LATENCY { 4 };
+    static constexpr std::size_t HISTORY_SIZE { 240 };
+    static constexpr std::size_t MAX_CAPTURED_FRAMES { 10000 };
+
+    // Times are nanoseconds since the profiler was created; GPU times are shifted onto the same clock.
+    struct Zone {
+        const char* name; // Must outlive the profiler; string literals are the intended use.
+        int depth {};
+        std::int64_t cpuBegin {};
+        std::int64_t cpuEnd {};
+        std::int64_t gpuBegin {};
+        std::int64_t gpuEnd {};
+    };
+
+    struct Frame {
+        std::uint64_t index {};
+        std::int64_t cpuBegin {};
+        std::int64_t cpuEnd {};
+        std::int64_t gpuBegin {};
+        std::int64_t gpuEnd {};
+        bool hasGpuTimes {};
+        std::vector<Zone> zones;
+    };
+
+private:
+    struct PendingFrame {
+        Frame frame;
+        std::vector<GLuint> queries; // Two per zone, then two for the frame itself; grows as needed.
+        std::size_t queriesUsed {};
+        std::int64_t gpuToCpuOffset {};
+        bool inFlight {};
+    };
+
+    std::chrono::steady_clock::time_point m_epoch;
+    bool m_gpuTiming {};
+
+    std::array<PendingFrame, FRAME_LATENCY> m_pending {};
+    std::size_t m_current {};
+    std::uint64_t m_frameIndex {};
+    bool m_inFrame {};
+    std::vector<std::size_t> m_openZones; // Indices into the current frame's zones.
+
+    std::deque<Frame> m_history;
+    std::vector<Frame> m_capture;
+    bool m_capturing {};
+    std::string m_outputPath;
+
+    // Panel state.
+    bool m_paused {};
+    int m_selectedFrame {}; // Frames back from the newest.
+    bool m_flameShowsGpu { true };
+
+    [[nodiscard]] std::int64_t now() const;
+    GLuint nextQuery(PendingFrame& pending);
+    void resolve(PendingFrame& pending, bool readGpu);
+    void resolveAvailable();
+    void publish(Frame&& frame);
+
+    void drawTimeline(const Frame& frame) const;
+    void drawFlameGraph() const;
+
+public:
+    Profiler();
+    ~Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void beginFrame();
+    void endFrame();
+    void beginZone(const char* name);
+    void endZone();
+
+    void drawImGui();
+
+    // Captured frames go to the trace, newest HISTORY_SIZE frames otherwise.
+    void startCapture();
+    void stopCapture();
+    bool writeChromeTrace(const std::string& path) const;
+
+    [[nodiscard]] const std::deque<Frame>& getHistory() const {
+        return m_history;
+    }
+    [[nodiscard]] bool hasGpuTiming() const {
+        return m_gpuTiming;
+    }
+};
+
+class ProfileZone {
+private:
+    Profiler& m_profiler;
+
+public:
+    ProfileZone(Profiler& profiler, const char* name) : m_profiler(profiler) {
+        m_profiler.beginZone(name);
+    }
+    ~ProfileZone() {
+        m_profiler.endZone();
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
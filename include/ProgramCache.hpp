@@ -0,0 +1,30 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+// On-disk cache of linked program binaries (glGetProgramBinary / glProgramBinary, GL 4.1+).
+// Entries are keyed by the shader sources together with GL_VENDOR, GL_RENDERER and GL_VERSION, so a
+// driver update or a different GPU simply misses instead of feeding the driver a foreign binary.
+// The directory comes from COREGL_SHADER_CACHE_DIR, or "shader_cache" next to the working directory;
+// setting it to an empty string turns the cache off.
+class ProgramCache {
+private:
+    static std::filesystem::path entryPath(std::uint64_t key);
+
+public:
+    static void setDirectory(const std::filesystem::path& directory);
+    [[nodiscard]] static const std::filesystem::path& getDirectory();
+    // False without a current GL 4.1+ context, with no binary formats, or when the cache is turned off.
+    [[nodiscard]] static bool isEnabled();
+
+    [[nodiscard]] static std::uint64_t makeKey(std::string_view vertexCode, std::string_view fragmentCode);
+
+    // Loads the cached binary into program. Returns false if there is no entry or the driver rejects it,
+    // in which case program is left unlinked and can be compiled from source as usual.
+    static bool load(GLuint program, std::uint64_t key);
+    // Writes program's binary. Set GL_PROGRAM_BINARY_RETRIEVABLE_HINT before linking it.
+    static void store(GLuint program, std::uint64_t key);
+};
@@ -1,30 +1,137 @@
 #pragma once
 
 #include <glad/glad.h>
+#include <concepts>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "Hash.hpp"
+
+// Uniform name reduced to its hash. String literals are hashed at compile time, runtime strings on the spot,
+// so no std::string is ever built just to look a uniform up.
+struct UniformName {
+    std::uint64_t hash {};
+
+    template <std::size_t N>
+    consteval UniformName(const char (&name)[N]) : hash { fnv1a64(std::string_view(name, N - 1)) } {}
+    // Runtime C strings. A template like the literal overload so literals still prefer the one above, which
+    // is more specialized.
+    template <typename T>
+        requires std::same_as<T, const char*> || std::same_as<T, char*>
+    UniformName(const T name) : hash { fnv1a64(std::string_view(name)) } {}
+    UniformName(const std::string_view name) : hash { fnv1a64(name) } {}
+    UniformName(const std::string &name) : hash { fnv1a64(name) } {}
+};
+
+// Typed handle returned by Shader::getUniform. Setting through a handle skips the name lookup entirely.
+// Only valid with the Shader that returned it.
+template <typename T>
+struct Uniform {
+    GLint slot {-1};
+};
+
 class Shader {
 private:
     GLuint m_ID;
-    void checkCompileErrors(GLuint shader, const std::string &type) const;
+    std::string m_vertexPath;
+    std::string m_fragmentPath;
+    // Stage objects of a link that has been submitted but not checked yet.
+    GLuint m_vertex {};
+    GLuint m_fragment {};
+    bool m_linkPending {};
+    std::uint64_t m_cacheKey {};
+    // Replacement program being built by reload(); m_ID stays in use until it links.
+    GLuint m_reloadProgram {};
+    GLuint m_reloadVertex {};
+    GLuint m_reloadFragment {};
+    std::uint64_t m_reloadKey {};
+    // Every active uniform of the linked program, filled once after link.
+    std::unordered_map<std::uint64_t, GLint> m_uniformLocations;
+    // Locations handed out as Uniform<T> handles, indexed by Uniform::slot.
+    mutable std::vector<std::uint64_t> m_handleHashes;
+    mutable std::vector<GLint> m_handleLocations;
+
+    static bool readSources(const std::string& vertexPath, const std::string& fragmentPath, std::string& vertexCode,
+                            std::string& fragmentCode);
+    static void submitCompile(GLuint program, const char* vShaderCode, const char* fShaderCode, GLuint& vertex,
+                              GLuint& fragment);
+    // Reports the errors and returns whether the stage compiled / the program linked.
+    bool checkCompileErrors(GLuint shader, const std::string &type) const;
+    void discardReload();
+    void cacheUniformLocations();
+    GLint findUniform(std::uint64_t nameHash) const;
+    GLint resolveHandle(UniformName name) const;
+    // Location behind a handle; -1, after printing why, for a slot this shader never gave out.
+    GLint handleLocation(GLint slot) const;
 
 public:
+    // Tag for the constructor that only submits the compile and link, see ShaderBatch.
+    struct DeferredLink {};
+
     Shader(const char* vertexPath, const char* fragmentPath);
+    Shader(const char* vertexPath, const char* fragmentPath, DeferredLink);
     ~Shader();
 
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    // Never blocks. Always true without KHR_parallel_shader_compile, where finishLink() blocks instead.
+    [[nodiscard]] bool isLinkComplete() const;
+    // Reports compile/link errors and builds the uniform table. Must run before the shader is used.
+    void finishLink();
+    [[nodiscard]] bool isLinkPending() const {
+        return m_linkPending;
+    }
+
+    // Rebuilds the program from the files it was made from, e.g. after they were edited (see ShaderWatcher).
+    // Only submits the work; the current program keeps being used until finishReload() swaps the new one in.
+    // A reload still in flight is dropped for the newer sources.
+    void reload();
+    [[nodiscard]] bool isReloadPending() const {
+        return m_reloadProgram != 0;
+    }
+    // Call between frames. Returns true once the rebuilt program has replaced the old one: uniform values
+    // are carried over and every Uniform<T> handle points at the new locations. If the new sources fail
+    // to compile or link the errors are printed and the old program stays. Without
+    // KHR_parallel_shader_compile, or with wait set, it blocks until the driver is done.
+    bool finishReload(bool wait = false);
+
     void use() const;
+    [[nodiscard]] GLuint getID() const {
+        return m_ID;
+    }
+    [[nodiscard]] const std::string& getVertexPath() const {
+        return m_vertexPath;
+    }
+    [[nodiscard]] const std::string& getFragmentPath() const {
+        return m_fragmentPath;
+    }
+
+    template <typename T>
+    Uniform<T> getUniform(const UniformName name) const {
+        return Uniform<T>{ resolveHandle(name) };
+    }
+
+    void setBool(UniformName varName, GLboolean value) const;
+    void setInt(UniformName varName, GLint value) const;
+    void setFloat(UniformName varName, GLfloat value) const;
+    void setVec2(UniformName varName, GLfloat x, GLfloat y) const;
+    void setVec3(UniformName varName, GLfloat x, GLfloat y,  GLfloat z) const;
+    void setVec4(UniformName varName, GLfloat x,  GLfloat y,  GLfloat z,  GLfloat w) const;
+    void setColor(UniformName varName, GLfloat r,  GLfloat g,  GLfloat b) const;
+    void setMat4(UniformName varName, const glm::mat4 &mat) const;
 
-    void setBool(const std::string &varName, GLboolean value) const;
-    void setInt(const std::string &varName, GLint value) const;
-    void setFloat(const std::string &varName, GLfloat value) const;
-    void setVec2(const std::string &varName, GLfloat x, GLfloat y) const;
-    void setVec3(const std::string &varName, GLfloat x, GLfloat y,  GLfloat z) const;
-    void setVec4(const std::string &varName, GLfloat x,  GLfloat y,  GLfloat z,  GLfloat w) const;
-    void setColor(const std::string &varName, GLfloat r,  GLfloat g,  GLfloat b) const;
-    void setMat4(const std::string &varName, const glm::mat4 &mat) const;
-};
\ No newline at end of file
+    void set(Uniform<GLint> uniform, GLint value) const;
+    void set(Uniform<GLfloat> uniform, GLfloat value) const;
+    void set(Uniform<glm::vec2> uniform, const glm::vec2 &value) const;
+    void set(Uniform<glm::vec3> uniform, const glm::vec3 &value) const;
+    void set(Uniform<glm::vec4> uniform, const glm::vec4 &value) const;
+    void set(Uniform<glm::mat4> uniform, const glm::mat4 &value) const;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <deque>
+#include "Shader.hpp"
+
+// Compiles many programs at once. add() only submits the work, so a driver with
+// KHR_parallel_shader_compile spreads it over its compiler threads while the caller keeps drawing
+// (e.g. a loading screen) and polls. Shaders stay owned by the batch; keep it alive while using them.
+class ShaderBatch {
+private:
+    std::deque<Shader> m_shaders; // deque: references returned by add() stay valid.
+    std::size_t m_pending {};
+    static bool s_compilerThreadsSet;
+
+public:
+    // The first batch lets the driver use as many compiler threads as it wants.
+    ShaderBatch();
+
+    Shader& add(const char* vertexPath, const char* fragmentPath);
+
+    // Finishes the programs the driver is done with and returns true once none are left. Without the
+    // extension completion cannot be queried, so each call finishes a single program instead.
+    bool poll();
+    // Finishes everything, blocking as needed.
+    void wait();
+
+    [[nodiscard]] std::size_t getPendingCount() const {
+        return m_pending;
+    }
+};
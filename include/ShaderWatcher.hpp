@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Shader.hpp"
+
+// Shader hot reload: edit a .vert/.frag file while the scene runs and the program is rebuilt in place.
+// A background thread waits for the files to change (inotify on Linux, a timestamp poll elsewhere) and
+// only records which ones did; update(), called once per frame on the GL thread, submits the rebuilds
+// and swaps each finished program in with Shader::finishReload(). With KHR_parallel_shader_compile the
+// compile runs on the driver's threads across frames; a program that fails to build is reported and the
+// old one keeps drawing.
+class ShaderWatcher {
+private:
+    struct WatchedShader {
+        Shader* shader;
+        std::string vertexPath;   // Files watched: absolute and normalised, like the paths the thread reports.
+        std::string fragmentPath;
+    };
+
+    struct Mirror {
+        std::filesystem::path source;
+        std::filesystem::path runtime;
+    };
+
+    std::vector<WatchedShader> m_shaders;
+    std::vector<Mirror> m_mirrors;
+    std::unordered_map<std::string, std::string> m_copies; // Watched source file to the copy the shader reads.
+    std::thread m_thread;
+    std::atomic<bool> m_stopping {};
+
+    std::mutex m_mutex; // Guards everything below, shared with the thread.
+    std::unordered_set<std::string> m_changed;
+    // Polling fallback: every watched file with the write time last seen.
+    std::unordered_map<std::string, std::filesystem::file_time_type> m_writeTimes;
+    int m_inotify { -1 };
+    std::unordered_map<int, std::string> m_directories; // inotify watch descriptor to directory.
+
+    static std::string normalise(const std::string& path);
+    // The file to watch for a path a shader reads: its source through a mirror, or the path itself.
+    std::string watchedFile(const std::string& path);
+    void addFile(const std::string& path);
+    void watchLoop();
+    void pollWriteTimes();
+
+public:
+    ShaderWatcher();
+    ~ShaderWatcher();
+
+    ShaderWatcher(const ShaderWatcher&) = delete;
+    ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+    // The exercises read resources copied next to the executable at build time. With a mirror, shaders read
+    // from under runtimeDirectory are watched at the same place under sourceDirectory instead, and an edited
+    // file is copied over before the rebuild. Call before watch().
+    void mirror(const std::string& sourceDirectory, const std::string& runtimeDirectory);
+    // The shader must outlive the watcher or be unwatched first.
+    void watch(Shader& shader);
+    void unwatch(const Shader& shader);
+
+    // Starts rebuilds for edited files and swaps finished programs in; returns how many were swapped.
+    // Call between frames, e.g. right before drawing.
+    std::size_t update();
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Packs rectangles into a fixed area with the skyline bottom-left heuristic. The skyline is the top edge
+// of everything placed so far; each rectangle goes where its top ends lowest, ties broken by the least
+// space wasted underneath. Cheap enough to pack at run time, and offline too (atlas_pack sorts by height
+// first, which packs tighter).
+class SkylinePacker {
+public:
+    struct Rect {
+        int x {};
+        int y {};
+        int width {};
+        int height {}; // 0 when insert() found no room.
+    };
+
+private:
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+
+    int m_width {};
+    int m_height {};
+    long long m_usedArea {};
+    std::vector<Segment> m_skyline;
+
+    // Lowest y at which a width-wide rectangle starting at segment index rests, or -1 if it does not fit.
+    [[nodiscard]] int restingHeight(std::size_t index, int width, int height) const;
+
+public:
+    SkylinePacker(int width, int height);
+
+    Rect insert(int width, int height);
+    void reset();
+
+    // Fraction of the area covered by placed rectangles.
+    [[nodiscard]] float getOccupancy() const;
+    [[nodiscard]] int getWidth() const {
+        return m_width;
+    }
+    [[nodiscard]] int getHeight() const {
+        return m_height;
+    }
+};
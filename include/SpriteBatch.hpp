@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "VAO.hpp"
+#include "EBO.hpp"
+#include "StreamBuffer.hpp"
+#include "Shader.hpp"
+#include "Texture.hpp"
+#include "TextureArray.hpp"
+#include "BindlessTextureTable.hpp"
+
+// Collects textured quads and draws them with as few glDrawElements calls as possible.
+// Quads are transformed on the CPU into the 7-float layout the exercises already use
+// (position xy, color rgb, uv) plus a layer at location 3, sorted by shader and texture, streamed through
+// a StreamBuffer and drawn against one shared quad index buffer. The shader only needs the projection,
+// which it reads from the FrameData block (see FrameData.hpp).
+//
+// The layer is 0 for plain textures. Sprites drawn from a TextureArray carry their layer, and sprites drawn
+// through a BindlessTextureTable their slot, so the shader picks the image and changing it between sprites
+// does not start a new draw call.
+class SpriteBatch {
+public:
+    // Storage buffer binding the bindless overloads bind their table to.
+    static constexpr GLuint TEXTURE_HANDLE_BINDING { 0 };
+
+private:
+    static constexpr int FLOATS_PER_VERTEX { 8 };
+    static constexpr int FLOATS_PER_SPRITE { 4 * FLOATS_PER_VERTEX };
+    static constexpr GLsizei STRIDE { FLOATS_PER_VERTEX * sizeof(GLfloat) };
+
+    struct Material {
+        const Shader* shader;
+        GLenum target;   // 0 for a bindless table.
+        GLuint texture;
+        BindlessTextureTable* table;
+    };
+
+    // A stream and the VAO reading from it. A frame with more sprites than one region holds moves on to the
+    // next chunk, so regions are only retired by end() and a busy frame never waits on its own fences.
+    struct StreamChunk {
+        StreamBuffer stream;
+        VAO vao;
+
+        StreamChunk(GLsizeiptr regionSize, const EBO& ebo);
+    };
+
+    std::size_t m_capacity {};
+    EBO m_EBO;
+    std::vector<std::unique_ptr<StreamChunk>> m_chunks; // Grows to the largest frame seen.
+    std::size_t m_chunk {};                             // Chunk the next batch of this frame goes to.
+
+    std::vector<GLfloat> m_vertices;
+    std::vector<Material> m_materials;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> m_order; // (shader << 32 | texture or table, sprite)
+    std::uint32_t m_drawCalls {};
+
+    static std::vector<GLuint> makeQuadIndices(std::size_t capacity);
+    GLfloat* pushSprite(const Material& material, std::uint32_t textureKey);
+    static void writeVertex(GLfloat* vertex, GLfloat x, GLfloat y, const glm::vec3& color, GLfloat u, GLfloat v,
+                            GLfloat layer);
+    static void writeQuad(GLfloat* vertex, const glm::mat4& transform, const glm::vec3& color, const glm::vec4& uvRect,
+                          GLfloat layer);
+    static void writeQuad(GLfloat* vertex, const glm::vec2& position, const glm::vec2& size, GLfloat rotation,
+                          const glm::vec3& color, const glm::vec4& uvRect, GLfloat layer);
+
+public:
+    // capacity is the number of sprites drawn per batch. Frames with more are flushed in several batches;
+    // once one stream region is full the rest go to further streams, created the first time a frame needs them.
+    explicit SpriteBatch(std::size_t capacity = 16384);
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    // Unit quad centered on the origin, transformed like the quads in GuiPlayground/Projection.
+    // uvRect is (u0, v0, u1, v1).
+    void draw(const Shader& shader, const Texture& texture, const glm::mat4& transform,
+              const glm::vec3& color = glm::vec3(1.0f), const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    // Same quad without building a matrix: centered on position, size in pixels, rotation in radians.
+    void draw(const Shader& shader, const Texture& texture, const glm::vec2& position, const glm::vec2& size,
+              GLfloat rotation = 0.0f, const glm::vec3& color = glm::vec3(1.0f),
+              const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+
+    // Same quads showing one layer of a texture array; the shader samples a sampler2DArray on unit 0.
+    void draw(const Shader& shader, const TextureArray& textureArray, GLint layer, const glm::mat4& transform,
+              const glm::vec3& color = glm::vec3(1.0f), const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    void draw(const Shader& shader, const TextureArray& textureArray, GLint layer, const glm::vec2& position,
+              const glm::vec2& size, GLfloat rotation = 0.0f, const glm::vec3& color = glm::vec3(1.0f),
+              const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    // Same quads showing the texture in a bindless table slot; the table is bound to TEXTURE_HANDLE_BINDING
+    // when the sprites are flushed.
+    void draw(const Shader& shader, BindlessTextureTable& table, std::uint32_t slot, const glm::mat4& transform,
+              const glm::vec3& color = glm::vec3(1.0f), const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    void draw(const Shader& shader, BindlessTextureTable& table, std::uint32_t slot, const glm::vec2& position,
+              const glm::vec2& size, GLfloat rotation = 0.0f, const glm::vec3& color = glm::vec3(1.0f),
+              const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+
+    // Submits everything queued so far. Can be called several times per frame (e.g. before ImGui).
+    void flush();
+    // flush() plus retiring this frame's stream region. Call once per frame.
+    void end();
+
+    // Draw calls issued by the flushes since the last end().
+    [[nodiscard]] std::uint32_t getDrawCallCount() const {
+        return m_drawCalls;
+    }
+};
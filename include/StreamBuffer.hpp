@@ -0,0 +1,64 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <array>
+
+// Buffer for data rewritten every frame (dynamic vertices, per-instance data, uniforms).
+// On GL 4.4+ it is one persistently mapped, coherent allocation split into three regions; each frame
+// writes into its own region and a fence keeps the CPU from overwriting a region the GPU still reads.
+// On older contexts it falls back to orphaning the buffer each frame and mapping it unsynchronized.
+class StreamBuffer {
+public:
+    static constexpr int REGION_COUNT { 3 };
+
+    struct Allocation {
+        void* data {};        // Where to write; nullptr when the frame's region is full.
+        GLintptr offset {};   // Byte offset of data inside the buffer, for attribute pointers and draws.
+    };
+
+private:
+    GLuint m_ID {};
+    GLenum m_target {};
+    GLsizeiptr m_regionSize {};
+    bool m_persistent {};
+
+    GLubyte* m_mappedData {};   // Persistent: start of the buffer. Fallback: start of the current mapping.
+    GLintptr m_mappedOffset {}; // Fallback only: buffer offset m_mappedData points at.
+    GLintptr m_cursor {};       // Write position inside the current region.
+    int m_region {};
+    std::array<GLsync, REGION_COUNT> m_fences {};
+
+    [[nodiscard]] GLintptr regionBase() const {
+        return m_persistent ? m_region * m_regionSize : 0;
+    }
+
+public:
+    StreamBuffer(GLenum target, GLsizeiptr regionSize);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Reserves size bytes in this frame's region. alignment does not have to be a power of two,
+    // so passing the vertex stride yields offsets usable as a base vertex.
+    Allocation allocate(GLsizeiptr size, GLsizeiptr alignment = 4);
+    // Makes everything allocated so far visible to the GPU. Call before drawing from the buffer.
+    void flush();
+    // Retires this frame's region and moves to the next one, waiting only if the GPU is 3 frames behind.
+    void endFrame();
+
+    void bind() const;
+    [[nodiscard]] GLuint getID() const {
+        return m_ID;
+    }
+    [[nodiscard]] GLsizeiptr getRegionSize() const {
+        return m_regionSize;
+    }
+    // Bytes still free in this frame's region, before alignment padding.
+    [[nodiscard]] GLsizeiptr getFreeBytes() const {
+        return m_regionSize - m_cursor;
+    }
+    [[nodiscard]] bool isPersistent() const {
+        return m_persistent;
+    }
+};
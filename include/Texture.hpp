@@ -6,6 +6,8 @@
 
 #include "glad/glad.h"
 #include "stb_image.h"
+#include "MipChain.hpp"
+#include "CompressedImage.hpp"
 
 class Texture {
 private:
@@ -13,9 +15,28 @@ private:
     GLsizei m_width {};
     GLsizei m_height {};
     GLenum m_type {GL_TEXTURE_2D};
+    // Sized format of the immutable storage (GL 4.2+), 0 before the first upload or on older contexts.
+    // A different size or format needs a new texture object.
+    GLenum m_storageFormat {};
+    GLsizei m_levels {};
+    // Kept so a recreated texture object gets the same parameters back.
+    mutable GLint m_wrapMode {GL_REPEAT};
+    mutable GLint m_filterMode {GL_LINEAR};
+
+    void createObject();
+    void applyParameters() const;
+    // Allocates every level at once where glTexStorage2D exists.
+    void allocateStorage(GLsizei width, GLsizei height, GLsizei levels, GLenum sizedFormat);
+    void uploadLevel(GLint level, GLsizei width, GLsizei height, int numChannels, const void* pixels) const;
+    [[nodiscard]] static bool hasImmutableStorage();
 
 public:
+    // .ktx2 and .dds files are uploaded as compressed blocks, anything else is decoded through ImageCache.
     Texture(const char* texturePath, GLenum texType, GLenum unit);
+    // Texture showing a 1x1 gray placeholder until upload() gives it its image (see TextureLoader). Without
+    // the placeholder it has no storage until upload() or allocate(). Either way getID() stays the same
+    // through the first upload.
+    explicit Texture(GLenum texType, bool placeholder = true);
     ~Texture();
 
     void bind(GLenum textureUnit) const;
@@ -24,4 +45,45 @@ public:
     void setWrappingMode(GLint wrapMode) const;
 
     void setFilteringMode(GLint filterMode) const;
+
+    // Replaces the image and has the driver rebuild the mipmaps. While a GL_PIXEL_UNPACK_BUFFER is bound,
+    // pixels is a byte offset into that buffer instead of a client pointer.
+    void upload(const void* pixels, GLsizei width, GLsizei height, int numChannels);
+    // Replaces the image with a chain built by MipChain, every level uploaded as is. base is where the
+    // chain's bytes are: mips.getData(), or their offset in a bound GL_PIXEL_UNPACK_BUFFER.
+    void upload(const MipChain& mips, const void* base);
+    void upload(const MipChain& mips) {
+        upload(mips, mips.getData());
+    }
+    // Same for pre-compressed blocks. False, leaving the texture as it was, if the context cannot sample
+    // the format (see GLCapabilities::hasCompressedFormat).
+    bool upload(const CompressedImage& image, const void* base);
+    bool upload(const CompressedImage& image) {
+        return upload(image, image.getData());
+    }
+
+    // Storage for `levels` levels with undefined contents, filled piece by piece with uploadRegion().
+    void allocate(GLsizei width, GLsizei height, GLsizei levels, int numChannels);
+    // Overwrites a rectangle of one level; pixels follows the same unpack buffer rule as upload().
+    void uploadRegion(GLint level, GLint x, GLint y, GLsizei width, GLsizei height, int numChannels,
+                      const void* pixels) const;
+
+    static GLenum formatForChannels(int numChannels);
+    // GL_R8 .. GL_RGBA8, what immutable storage needs instead of the unsized formats above.
+    static GLenum sizedFormatForChannels(int numChannels);
+    // Levels of a full mip chain down to 1x1.
+    static GLsizei mipLevelCount(GLsizei width, GLsizei height);
+
+    [[nodiscard]] GLuint getID() const {
+        return m_ID;
+    }
+    [[nodiscard]] GLenum getType() const {
+        return m_type;
+    }
+    [[nodiscard]] GLsizei getWidth() const {
+        return m_width;
+    }
+    [[nodiscard]] GLsizei getHeight() const {
+        return m_height;
+    }
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "MipChain.hpp"
+
+// GL_TEXTURE_2D_ARRAY of same-sized images. Each image is a layer, chosen in the shader by an index that
+// comes from vertex or instance data (sampler2DArray, texture(s, vec3(uv, layer))), so quads showing
+// different images still share one bind and one draw. Unlike an atlas, every layer keeps its full mip
+// chain and repeat wrapping.
+class TextureArray {
+private:
+    GLuint m_ID {};
+    GLsizei m_width {};
+    GLsizei m_height {};
+    GLsizei m_capacity {};
+    GLsizei m_levels {};
+    GLsizei m_layerCount {};
+    int m_numChannels {};
+    GLint m_wrapMode {GL_REPEAT};
+    GLint m_filterMode {GL_LINEAR};
+
+    void applyParameters() const;
+    void uploadLevel(GLint level, GLint layer, GLsizei width, GLsizei height, const void* pixels) const;
+
+public:
+    // Storage for `capacity` layers of width x height with numChannels (1 to 4) is allocated up front,
+    // immutable where glTexStorage3D exists. levels = 0 means a full chain down to 1x1.
+    TextureArray(GLsizei width, GLsizei height, GLsizei capacity, int numChannels = 4, GLsizei levels = 0);
+    ~TextureArray();
+
+    TextureArray(const TextureArray&) = delete;
+    TextureArray& operator=(const TextureArray&) = delete;
+
+    // Appends an image and returns its layer, or -1 (after printing why) if the array is full or the
+    // image's size or channel count differ from the array's. The mip chain is built on the CPU.
+    GLint addLayer(const GLubyte* pixels, GLsizei width, GLsizei height, int numChannels);
+    // Decodes the file through ImageCache, converted to the array's channel count.
+    GLint addLayer(const char* path);
+    // Overwrites an existing layer with a chain of the array's size, e.g. one built on a loader thread.
+    void setLayer(GLint layer, const MipChain& mips) const;
+
+    void bind(GLenum textureUnit) const;
+    void unbind() const;
+
+    void setWrappingMode(GLint wrapMode);
+    void setFilteringMode(GLint filterMode);
+
+    [[nodiscard]] GLuint getID() const {
+        return m_ID;
+    }
+    [[nodiscard]] GLsizei getWidth() const {
+        return m_width;
+    }
+    [[nodiscard]] GLsizei getHeight() const {
+        return m_height;
+    }
+    [[nodiscard]] GLsizei getLayerCount() const {
+        return m_layerCount;
+    }
+    [[nodiscard]] GLsizei getCapacity() const {
+        return m_capacity;
+    }
+};
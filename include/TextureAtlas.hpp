@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Texture.hpp"
+#include "SkylinePacker.hpp"
+
+// Packs many small images into a few large RGBA8 textures (pages) so they share one bind, and with
+// SpriteBatch one draw. add() returns the page and the UV rectangle the image landed in; a new page is
+// opened when the current ones are full.
+//
+// Each image is surrounded by a gutter of copied edge texels and placed on a grid of the same size, both
+// 2^(mipLevels - 1) texels. That keeps bilinear filtering and every one of the page's mip levels from
+// reading a neighbour's texels; the pages stop at mipLevels levels, since smaller ones would mix images.
+class TextureAtlas {
+public:
+    struct Region {
+        const Texture* texture {}; // Page the image is on; nullptr if it could not be added.
+        glm::vec4 uvRect {};       // (u0, v0, u1, v1), as SpriteBatch::draw takes it.
+        int page {};
+    };
+
+private:
+    struct Page {
+        std::unique_ptr<Texture> texture;
+        SkylinePacker packer;
+    };
+
+    GLsizei m_pageSize {};
+    GLsizei m_mipLevels {};
+    std::vector<Page> m_pages;
+
+    Page& openPage();
+
+public:
+    explicit TextureAtlas(GLsizei pageSize = 2048, GLsizei mipLevels = 3);
+
+    // pixels is a decoded image, rows bottom to top like Texture's, 1 to 4 channels (stored as RGBA).
+    Region add(const GLubyte* pixels, GLsizei width, GLsizei height, int numChannels);
+    // Decodes the file through ImageCache first, so warm starts skip the decoder.
+    Region add(const std::string& path);
+
+    // Gutter and grid size for a page that keeps mipLevels clean levels.
+    [[nodiscard]] static GLsizei gutterForLevels(GLsizei mipLevels);
+    // Writes the image with its gutter as RGBA into a paddedWidth x paddedHeight block of destination,
+    // whose rows are rowLength texels apart. Padding beyond the gutter repeats the edge as well.
+    static void writePadded(const GLubyte* pixels, GLsizei width, GLsizei height, int numChannels, GLsizei gutter,
+                            GLsizei paddedWidth, GLsizei paddedHeight, GLubyte* destination, std::size_t rowLength);
+    // Name to UV rectangle table written next to an atlas baked by atlas_pack; empty if unreadable.
+    [[nodiscard]] static std::unordered_map<std::string, glm::vec4> readManifest(const std::string& path);
+
+    [[nodiscard]] std::size_t getPageCount() const {
+        return m_pages.size();
+    }
+    [[nodiscard]] const Texture& getPage(const std::size_t index) const {
+        return *m_pages[index].texture;
+    }
+    [[nodiscard]] float getOccupancy(const std::size_t index) const {
+        return m_pages[index].packer.getOccupancy();
+    }
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Texture.hpp"
+#include "StreamBuffer.hpp"
+
+// Loads textures without stalling the render thread. load() returns a Texture right away, showing a
+// placeholder; worker threads decode the file and build its mip chain through ImageCache (or read a KTX2/DDS
+// file's blocks), and update(), called once per frame on the GL thread, uploads finished chains through a pixel unpack buffer until its time budget runs out.
+class TextureLoader {
+private:
+    struct Request {
+        std::shared_ptr<Texture> texture;
+        std::string path;
+    };
+
+    struct DecodedImage {
+        std::shared_ptr<Texture> texture;
+        std::string path;
+        // One of the two is filled, depending on the file; both are empty if it could not be read.
+        MipChain mips;
+        CompressedImage compressed;
+
+        [[nodiscard]] GLsizeiptr getSize() const {
+            return static_cast<GLsizeiptr>(compressed.empty() ? mips.getSize() : compressed.getSize());
+        }
+        [[nodiscard]] const GLubyte* getData() const {
+            return compressed.empty() ? mips.getData() : compressed.getData();
+        }
+    };
+
+    std::vector<std::thread> m_workers;
+    std::deque<Request> m_requests;
+    std::deque<DecodedImage> m_decoded;
+    std::mutex m_mutex;
+    std::condition_variable m_requestAdded;
+    std::condition_variable m_imageDecoded;
+    std::size_t m_pending {};
+    bool m_stopping {};
+
+    StreamBuffer m_staging;
+
+    static constexpr GLsizeiptr ALIGNMENT_SLACK { 4 };
+
+    void workerLoop();
+    [[nodiscard]] bool fitsStaging(GLsizeiptr size) const;
+    void uploadImage(DecodedImage& image);
+
+public:
+    // One thread fewer than the hardware runs, leaving a core to the render thread; at least 1, also when the
+    // count is unknown.
+    [[nodiscard]] static unsigned defaultWorkerCount();
+
+    // stagingBytesPerFrame bounds how much pixel data goes through the unpack buffer in one frame.
+    explicit TextureLoader(unsigned workerCount = defaultWorkerCount(),
+                           GLsizeiptr stagingBytesPerFrame = 32 * 1024 * 1024);
+    ~TextureLoader();
+
+    TextureLoader(const TextureLoader&) = delete;
+    TextureLoader& operator=(const TextureLoader&) = delete;
+
+    std::shared_ptr<Texture> load(const std::string& path, GLenum texType = GL_TEXTURE_2D);
+
+    // Uploads decoded images until budget is spent (always at least one). Call once per frame.
+    void update(std::chrono::microseconds budget = std::chrono::microseconds(2000));
+    // Blocks until every requested texture has been uploaded, e.g. behind a loading screen.
+    void waitAll();
+
+    // Textures requested but not uploaded yet.
+    [[nodiscard]] std::size_t getPendingCount();
+};
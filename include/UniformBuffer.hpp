@@ -0,0 +1,94 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <glm/glm.hpp>
+
+// std140 rules for the C++ mirror of a uniform block. Only types whose C++ layout can match std140
+// member by member are accepted: scalars, vectors and mat4. bool (1 byte in C++, 4 in GLSL), mat3
+// (columns padded to vec4) and arrays (every element padded to 16 bytes) have no such mirror and fail
+// to compile; spell them as int, mat4 or vec4 instead.
+namespace std140 {
+    template <typename T>
+    consteval std::size_t baseAlignment() {
+        if constexpr (std::is_same_v<T, float> || std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::uint32_t>) {
+            return 4;
+        } else if constexpr (std::is_same_v<T, glm::vec2> || std::is_same_v<T, glm::ivec2> || std::is_same_v<T, glm::uvec2>) {
+            return 8;
+        } else if constexpr (std::is_same_v<T, glm::vec3> || std::is_same_v<T, glm::ivec3> || std::is_same_v<T, glm::uvec3>
+                             || std::is_same_v<T, glm::vec4> || std::is_same_v<T, glm::ivec4> || std::is_same_v<T, glm::uvec4>
+                             || std::is_same_v<T, glm::mat4>) {
+            return 16;
+        } else {
+            static_assert(!sizeof(T), "type has no std140 equivalent with the same C++ layout");
+            return 0;
+        }
+    }
+
+    template <typename T>
+    consteval bool isAligned(const std::size_t offset) {
+        return offset % baseAlignment<T>() == 0;
+    }
+
+    // Blocks are bound whole, and GL rounds their size up to a vec4.
+    template <typename Block>
+    consteval bool isBlockSize() {
+        return std::is_standard_layout_v<Block> && sizeof(Block) % 16 == 0;
+    }
+}
+
+// Checks, at compile time, that Block::member sits where std140 puts it. A vec3 followed by a float is
+// fine; a vec3 followed by a vec3 needs a float of padding in between.
+#define STD140_CHECK_MEMBER(Block, member) \
+    static_assert(std140::isAligned<decltype(Block::member)>(offsetof(Block, member)), \
+                  #Block "::" #member " is not std140 aligned")
+#define STD140_CHECK_BLOCK(Block) \
+    static_assert(std140::isBlockSize<Block>(), #Block " must be standard layout and a multiple of 16 bytes")
+
+// Buffer backing a std140 uniform block. Each one owns a fixed binding point, so every program that
+// declares the block reads the same data and a single update() replaces one glUniform* call per
+// program. Programs find the binding point through the block's name, see registerBlock().
+class UniformBuffer {
+private:
+    GLuint m_ID {};
+    GLsizeiptr m_size {};
+    GLuint m_binding {};
+
+public:
+    UniformBuffer(GLsizeiptr size, GLuint binding);
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    // Writes size bytes at offset and leaves the buffer bound to its binding point.
+    void update(const void* data, GLsizeiptr size, GLintptr offset = 0) const;
+    template <typename Block>
+    void update(const Block& block) const {
+        STD140_CHECK_BLOCK(Block);
+        update(&block, sizeof(Block));
+    }
+
+    void bind() const;
+
+    // Shader assigns every uniform block named here to its binding point when it links, which GLSL 330
+    // cannot do itself (layout(binding) needs 4.20). size is what the C++ mirror occupies; a program
+    // whose block has another size is reported. Register before creating the shaders that use it.
+    // "FrameData" is registered from the start, see FrameData.hpp.
+    static void registerBlock(std::string_view blockName, GLuint binding, GLsizeiptr size);
+    // Binds the program's registered blocks. Called by Shader after every link.
+    static void assignBlockBindings(GLuint program);
+
+    [[nodiscard]] GLuint getID() const {
+        return m_ID;
+    }
+    [[nodiscard]] GLsizeiptr getSize() const {
+        return m_size;
+    }
+    [[nodiscard]] GLuint getBinding() const {
+        return m_binding;
+    }
+};
@@ -4,12 +4,31 @@
 #pragma once
 
 #include "VBO.hpp"
+#include "EBO.hpp"
+#include "StreamBuffer.hpp"
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 
 class VAO {
+public:
+    // How the shader sees an attribute. Float converts the stored values as they are; Normalized maps
+    // unsigned integers to [0, 1] and signed ones to [-1, 1] (GL_UNSIGNED_BYTE colors, GL_INT_2_10_10_10_REV
+    // normals); Integer keeps them integers for ivec/uvec inputs. See VertexPacking.hpp for the converters.
+    enum class AttribMode {
+        Float,
+        Normalized,
+        Integer
+    };
+
 private:
     GLuint m_ID{};
+
+    // With direct state access each attribute gets its own buffer binding point, numbered like its layout.
+    void linkBuffer(GLuint buffer, GLuint layout, GLint numComponents, GLenum type, GLsizei stride,
+                    const void* offset, GLuint divisor, AttribMode mode) const;
+    void linkMat4(GLuint buffer, GLuint layout, GLsizei stride, const void* offset, GLuint divisor) const;
+    // Bytes one attribute of numComponents takes; packed types hold every component in one value.
+    static GLsizei attribSize(GLint numComponents, GLenum type);
 public:
     VAO();
     ~VAO();
@@ -17,5 +36,30 @@ public:
     void bind() const;
     static void unbind();
 
-    void linkAttrib(const VBO& VBO, GLuint layout, GLint numComponents, GLenum type, GLsizei stride, const void* offset);
+    [[nodiscard]] GLuint getID() const {
+        return m_ID;
+    }
+
+    void linkAttrib(const VBO& VBO, GLuint layout, GLint numComponents, GLenum type, GLsizei stride, const void* offset,
+                    AttribMode mode = AttribMode::Float);
+    void linkAttrib(const StreamBuffer& buffer, GLuint layout, GLint numComponents, GLenum type, GLsizei stride,
+                    const void* offset, AttribMode mode = AttribMode::Float);
+
+    // Per-instance attributes: the value advances once every `divisor` instances instead of once per vertex.
+    void linkInstanceAttrib(const VBO& VBO, GLuint layout, GLint numComponents, GLenum type, GLsizei stride,
+                            const void* offset, GLuint divisor = 1, AttribMode mode = AttribMode::Float);
+    void linkInstanceAttrib(const StreamBuffer& buffer, GLuint layout, GLint numComponents, GLenum type,
+                            GLsizei stride, const void* offset, GLuint divisor = 1, AttribMode mode = AttribMode::Float);
+    // A mat4 takes four consecutive locations (layout .. layout + 3), one column each.
+    void linkInstanceMat4(const VBO& VBO, GLuint layout, GLsizei stride, const void* offset, GLuint divisor = 1);
+    void linkInstanceMat4(const StreamBuffer& buffer, GLuint layout, GLsizei stride, const void* offset,
+                          GLuint divisor = 1);
+    void setDivisor(GLuint layout, GLuint divisor);
+    // Attaches the index buffer; without direct state access this binds the VAO.
+    void setElementBuffer(const EBO& EBO) const;
+
+    // Binds this VAO and draws instanceCount copies of its indexed mesh in one call.
+    // A non-zero baseInstance (GL 4.2) offsets where the per-instance attributes start reading.
+    void drawElementsInstanced(GLenum mode, GLsizei count, GLenum indexType, GLsizei instanceCount,
+                               GLuint baseInstance = 0) const;
 };
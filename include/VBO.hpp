@@ -10,9 +10,14 @@ class VBO {
 private:
     GLuint m_ID {};
 public:
-    VBO(const GLfloat* vertices, GLsizeiptr size);
+    // Any vertex layout: plain floats or the packed formats of VertexPacking.hpp.
+    VBO(const void* vertices, GLsizeiptr size);
     ~VBO();
 
     void bind() const;
     static void unbind();
+
+    [[nodiscard]] GLuint getID() const {
+        return m_ID;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <glm/glm.hpp>
+
+// Float vertex data squeezed into the compact attribute types VAO::linkAttrib accepts:
+//   GL_HALF_FLOAT                     positions and UVs, 2 bytes a component (11 bits of precision, up to 65504)
+//   GL_UNSIGNED_BYTE, Normalized      colors in [0, 1], 1 byte a component
+//   GL_INT_2_10_10_10_REV, Normalized unit normals in [-1, 1], all four components in 4 bytes
+// The 7-float position/color/UV vertex of the exercises (28 bytes) fits in 12 this way.
+//
+// The bulk converters read count vertices of `components` floats, sourceStride floats apart, and write
+// them destinationStride bytes apart, so they can fill one attribute of an interleaved vertex at a time.
+// Tightly packed input and output take a straight loop the compiler vectorizes, and with F16C the
+// half conversion runs eight values per instruction.
+namespace VertexPacking {
+    // Round to nearest even; overflow becomes infinity, NaN stays a (quiet) NaN with the top of its payload.
+    GLhalf toHalf(float value);
+    float fromHalf(GLhalf value);
+    // Clamped to [0, 1]; NaN becomes 0.
+    GLubyte toUnorm8(float value);
+    // x, y, z in 10 bits each and w in 2, every one clamped to [-1, 1].
+    GLuint toSnorm1010102(glm::vec3 value, float w = 0.0f);
+
+    void packHalf(const float* source, std::size_t sourceStride, std::size_t components, std::size_t count,
+                  void* destination, std::size_t destinationStride);
+    void packUnorm8(const float* source, std::size_t sourceStride, std::size_t components, std::size_t count,
+                    void* destination, std::size_t destinationStride);
+    // Three floats a vertex (w = 0). Link the result with 4 components.
+    void packSnorm1010102(const float* source, std::size_t sourceStride, std::size_t count, void* destination,
+                          std::size_t destinationStride);
+}
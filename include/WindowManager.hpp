@@ -4,6 +4,12 @@
 #include "GLFW/glfw3.h"
 #include <iostream>
 #include <string>
+#include <memory>
+#include <vector>
+
+#include "HeadlessContext.hpp"
+#include "FrameBenchmark.hpp"
+#include "FrameScheduler.hpp"
 
 class WindowManager {
 private:
@@ -11,28 +17,49 @@ private:
     int m_width{};
     int m_height{};
 
-    float m_currentTime{};
-    float m_lastTime{};
+    FrameScheduler m_scheduler;
     float m_deltaTime{};
 
+    // Headless mode: no visible window, rendering goes through an EGL context into an FBO.
+    static bool s_headless;
+    static int s_contextMajor;
+    static int s_contextMinor;
+    std::unique_ptr<HeadlessContext> m_headlessContext;
+    long long m_frameCount{};
+    long long m_frameLimit{};
+
+    // Set when COREGL_BENCH_OUTPUT asks for a frame-time report (see the bench_frames target).
+    std::unique_ptr<FrameBenchmark> m_benchmark;
+
     static void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+    void initializeHeadlessContext();
 
 public:
     WindowManager();
     ~WindowManager();
 
     static void Log(const char* message);
+    // Must be called before initializeGLFW. Setting COREGL_HEADLESS=1 in the environment does the same,
+    // and COREGL_HEADLESS_FRAMES=N makes windowShouldClose() return true after N frames.
+    static void enableHeadless();
+    static bool isHeadless();
     static void initializeGLFW(int versionMajor, int versionMinor);
     void initializeWindow(int width, int height, const char *name);
     void beginDrawing();
     void endDrawing();
-    void destroyWindow() const;
+    void destroyWindow();
 
     bool windowShouldClose() const;
     GLFWwindow* getWindow() const;
 
     void toggleVsync(bool vsyncEnabled);
 
+    // Stops the loop after the given number of frames (0 means never).
+    void setFrameLimit(long long frames);
+    // Framebuffer the scene is drawn into: 0 for a window, the off-screen FBO in headless mode.
+    GLuint getFramebuffer() const;
+    void readPixels(std::vector<GLubyte>& pixels) const;
+
     int getWidth() const {
         return m_width;
     };
@@ -44,4 +71,14 @@ public:
     {
         return m_deltaTime;
     }
+    // Seconds since the first frame, exact at any uptime (unlike a float from glfwGetTime()).
+    [[nodiscard]] double getTime() const
+    {
+        return m_scheduler.getElapsedSeconds();
+    }
+    // Fixed-timestep updates, frame-rate cap and smoothed frame time.
+    FrameScheduler& getScheduler()
+    {
+        return m_scheduler;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "BindlessTextureTable.hpp"
+#include "GLStateCache.hpp"
+#include "GLCapabilities.hpp"
+#include <algorithm>
+#include <iostream>
+
+BindlessTextureTable::BindlessTextureTable() {
+    if (!isSupported()) {
+        return;
+    }
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glCreateBuffers(1, &m_buffer);
+    } else {
+        glGenBuffers(1, &m_buffer);
+    }
+}
+
+BindlessTextureTable::~BindlessTextureTable() {
+    for (const GLuint64 handle : m_handles) {
+        GLCapabilities::makeTextureHandleNonResident(handle);
+    }
+    if (m_buffer != 0) {
+        glDeleteBuffers(1, &m_buffer);
+        GLStateCache::onBufferDeleted(m_buffer);
+    }
+}
+
+bool BindlessTextureTable::isSupported() {
+    return GLCapabilities::hasBindlessTexture() && GLAD_GL_VERSION_4_3;
+}
+
+bool BindlessTextureTable::hasDivergentHandles() {
+    return GLCapabilities::hasExtension("GL_NV_gpu_shader5");
+}
+
+std::optional<std::uint32_t> BindlessTextureTable::add(const GLuint texture) {
+    if (!isSupported()) {
+        std::cout << "ERROR::BINDLESS_TEXTURE_TABLE::NOT_SUPPORTED" << std::endl;
+        return std::nullopt;
+    }
+    if (const auto found { m_slots.find(texture) }; found != m_slots.end()) {
+        return found->second;
+    }
+    const GLuint64 handle { GLCapabilities::getTextureHandle(texture) };
+    if (handle == 0) {
+        std::cout << "ERROR::BINDLESS_TEXTURE_TABLE::NO_HANDLE: texture " << texture << std::endl;
+        return std::nullopt;
+    }
+    GLCapabilities::makeTextureHandleResident(handle);
+
+    const auto slot { static_cast<std::uint32_t>(m_handles.size()) };
+    m_handles.push_back(handle);
+    m_slots.emplace(texture, slot);
+    m_dirty = true;
+    return slot;
+}
+
+void BindlessTextureTable::upload() {
+    const auto size { static_cast<GLsizeiptr>(m_handles.size() * sizeof(GLuint64)) };
+    const bool grow { size > m_bufferSize };
+    if (grow) {
+        m_bufferSize = std::max<GLsizeiptr>(size, 2 * m_bufferSize);
+    }
+    if (GLCapabilities::hasDirectStateAccess()) {
+        if (grow) {
+            glNamedBufferData(m_buffer, m_bufferSize, nullptr, GL_DYNAMIC_DRAW);
+        }
+        glNamedBufferSubData(m_buffer, 0, size, m_handles.data());
+    } else {
+        GLStateCache::bindBuffer(GL_SHADER_STORAGE_BUFFER, m_buffer);
+        if (grow) {
+            glBufferData(GL_SHADER_STORAGE_BUFFER, m_bufferSize, nullptr, GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, m_handles.data());
+    }
+    m_dirty = false;
+}
+
+void BindlessTextureTable::bind(const GLuint bindingPoint) {
+    if (m_buffer == 0 || m_handles.empty()) {
+        return;
+    }
+    if (m_dirty) {
+        upload();
+    }
+    GLStateCache::bindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingPoint, m_buffer);
+}
@@ -0,0 +1,422 @@
+#include "CompressedImage.hpp"
+#include "GLCapabilities.hpp" // S3TC enums
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <string_view>
+
+namespace {
+    // Khronos Data Format channel ids and qualifiers used by the KTX2 data format descriptor.
+    constexpr std::uint8_t CHANNEL_SIGNED { 0x40 };
+    constexpr std::uint8_t CHANNEL_FLOAT { 0x80 };
+
+    struct Sample {
+        std::uint8_t channel;
+        std::uint16_t bitOffset;
+    };
+
+    struct FormatInfo {
+        GLenum internalFormat;
+        std::uint32_t vkFormat;   // VkFormat, what KTX2 stores.
+        std::uint32_t dxgiFormat; // DXGI_FORMAT of a DDS DX10 header, 0 if DDS has none.
+        GLsizei blockBytes;
+        std::uint8_t colorModel;  // KHR_DF_MODEL_*
+        bool srgb;
+        std::uint8_t qualifiers;
+        std::uint8_t sampleCount;
+        std::array<Sample, 2> samples;
+    };
+
+    constexpr std::array<FormatInfo, 26> FORMATS {{
+        { GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 131, 0, 8, 128, false, 0, 1, {{ { 0, 0 } }} },
+        { GL_COMPRESSED_SRGB_S3TC_DXT1_EXT, 132, 0, 8, 128, true, 0, 1, {{ { 0, 0 } }} },
+        { GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 133, 71, 8, 128, false, 0, 1, {{ { 1, 0 } }} },
+        { GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 134, 72, 8, 128, true, 0, 1, {{ { 1, 0 } }} },
+        { GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, 135, 74, 16, 129, false, 0, 2, {{ { 15, 0 }, { 0, 64 } }} },
+        { GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, 136, 75, 16, 129, true, 0, 2, {{ { 15, 0 }, { 0, 64 } }} },
+        { GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 137, 77, 16, 130, false, 0, 2, {{ { 15, 0 }, { 0, 64 } }} },
+        { GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 138, 78, 16, 130, true, 0, 2, {{ { 15, 0 }, { 0, 64 } }} },
+        { GL_COMPRESSED_RED_RGTC1, 139, 80, 8, 131, false, 0, 1, {{ { 0, 0 } }} },
+        { GL_COMPRESSED_SIGNED_RED_RGTC1, 140, 81, 8, 131, false, CHANNEL_SIGNED, 1, {{ { 0, 0 } }} },
+        { GL_COMPRESSED_RG_RGTC2, 141, 83, 16, 132, false, 0, 2, {{ { 0, 0 }, { 1, 64 } }} },
+        { GL_COMPRESSED_SIGNED_RG_RGTC2, 142, 84, 16, 132, false, CHANNEL_SIGNED, 2, {{ { 0, 0 }, { 1, 64 } }} },
+        { GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT, 143, 95, 16, 133, false, CHANNEL_FLOAT, 1, {{ { 0, 0 } }} },
+        { GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT, 144, 96, 16, 133, false, CHANNEL_FLOAT | CHANNEL_SIGNED, 1,
+            {{ { 0, 0 } }} },
+        { GL_COMPRESSED_RGBA_BPTC_UNORM, 145, 98, 16, 134, false, 0, 1, {{ { 0, 0 } }} },
+        { GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM, 146, 99, 16, 134, true, 0, 1, {{ { 0, 0 } }} },
+        { GL_COMPRESSED_RGB8_ETC2, 147, 0, 8, 161, false, 0, 1, {{ { 2, 0 } }} },
+        { GL_COMPRESSED_SRGB8_ETC2, 148, 0, 8, 161, true, 0, 1, {{ { 2, 0 } }} },
+        { GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2, 149, 0, 8, 161, false, 0, 1, {{ { 2, 0 } }} },
+        { GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2, 150, 0, 8, 161, true, 0, 1, {{ { 2, 0 } }} },
+        { GL_COMPRESSED_RGBA8_ETC2_EAC, 151, 0, 16, 161, false, 0, 2, {{ { 15, 0 }, { 2, 64 } }} },
+        { GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC, 152, 0, 16, 161, true, 0, 2, {{ { 15, 0 }, { 2, 64 } }} },
+        { GL_COMPRESSED_R11_EAC, 153, 0, 8, 161, false, 0, 1, {{ { 0, 0 } }} },
+        { GL_COMPRESSED_SIGNED_R11_EAC, 154, 0, 8, 161, false, CHANNEL_SIGNED, 1, {{ { 0, 0 } }} },
+        { GL_COMPRESSED_RG11_EAC, 155, 0, 16, 161, false, 0, 2, {{ { 0, 0 }, { 1, 64 } }} },
+        { GL_COMPRESSED_SIGNED_RG11_EAC, 156, 0, 16, 161, false, CHANNEL_SIGNED, 2, {{ { 0, 0 }, { 1, 64 } }} },
+    }};
+
+    template <typename Predicate>
+    const FormatInfo* findFormat(Predicate predicate) {
+        const auto found { std::find_if(FORMATS.begin(), FORMATS.end(), predicate) };
+        return found != FORMATS.end() ? &*found : nullptr;
+    }
+
+    const FormatInfo* formatInfo(const GLenum internalFormat) {
+        return findFormat([internalFormat](const FormatInfo& info) { return info.internalFormat == internalFormat; });
+    }
+
+    constexpr std::array<GLubyte, 12> KTX2_IDENTIFIER {
+        0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+    };
+
+    struct KTX2Header {
+        std::uint32_t vkFormat;
+        std::uint32_t typeSize;
+        std::uint32_t pixelWidth;
+        std::uint32_t pixelHeight;
+        std::uint32_t pixelDepth;
+        std::uint32_t layerCount;
+        std::uint32_t faceCount;
+        std::uint32_t levelCount;
+        std::uint32_t supercompressionScheme;
+        std::uint32_t dfdByteOffset;
+        std::uint32_t dfdByteLength;
+        std::uint32_t kvdByteOffset;
+        std::uint32_t kvdByteLength;
+    };
+    static_assert(sizeof(KTX2Header) == 52);
+
+    // Kept apart from KTX2Header, whose size would otherwise be padded for the 64-bit fields.
+    struct KTX2SupercompressionIndex {
+        std::uint64_t sgdByteOffset;
+        std::uint64_t sgdByteLength;
+    };
+
+    struct KTX2LevelIndex {
+        std::uint64_t byteOffset;
+        std::uint64_t byteLength;
+        std::uint64_t uncompressedByteLength;
+    };
+
+    constexpr std::uint32_t DDS_MAGIC { 0x20534444 }; // "DDS "
+    constexpr std::uint32_t DDS_HEADER_SIZE { 124 };
+    constexpr std::uint32_t DDSD_MIPMAPCOUNT { 0x20000 };
+    constexpr std::uint32_t DDPF_FOURCC { 0x4 };
+    constexpr std::uint32_t DDS_DIMENSION_TEXTURE2D { 3 };
+    constexpr std::uint32_t DDS_RESOURCE_MISC_TEXTURECUBE { 0x4 };
+
+    struct DDSHeader {
+        std::uint32_t size;
+        std::uint32_t flags;
+        std::uint32_t height;
+        std::uint32_t width;
+        std::uint32_t pitchOrLinearSize;
+        std::uint32_t depth;
+        std::uint32_t mipMapCount;
+        std::uint32_t reserved1[11];
+        std::uint32_t pixelFormatSize;
+        std::uint32_t pixelFormatFlags;
+        std::uint32_t fourCC;
+        std::uint32_t rgbBitCount;
+        std::uint32_t masks[4];
+        std::uint32_t caps[4];
+        std::uint32_t reserved2;
+    };
+    static_assert(sizeof(DDSHeader) == DDS_HEADER_SIZE);
+
+    struct DDSHeaderDX10 {
+        std::uint32_t dxgiFormat;
+        std::uint32_t resourceDimension;
+        std::uint32_t miscFlag;
+        std::uint32_t arraySize;
+        std::uint32_t miscFlags2;
+    };
+
+    constexpr std::uint32_t fourCC(const char (&code)[5]) {
+        return static_cast<std::uint32_t>(code[0]) | static_cast<std::uint32_t>(code[1]) << 8
+            | static_cast<std::uint32_t>(code[2]) << 16 | static_cast<std::uint32_t>(code[3]) << 24;
+    }
+
+    GLenum ddsFourCCFormat(const std::uint32_t code) {
+        switch (code) {
+            case fourCC("DXT1"):
+                return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case fourCC("DXT3"):
+                return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case fourCC("DXT5"):
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case fourCC("ATI1"):
+            case fourCC("BC4U"):
+                return GL_COMPRESSED_RED_RGTC1;
+            case fourCC("BC4S"):
+                return GL_COMPRESSED_SIGNED_RED_RGTC1;
+            case fourCC("ATI2"):
+            case fourCC("BC5U"):
+                return GL_COMPRESSED_RG_RGTC2;
+            case fourCC("BC5S"):
+                return GL_COMPRESSED_SIGNED_RG_RGTC2;
+            default:
+                return 0;
+        }
+    }
+
+    // Dimensions GL can take as GLsizei, and no more levels than their full mip chain has.
+    bool isValidExtent(const std::uint32_t width, const std::uint32_t height, const std::uint32_t levelCount) {
+        constexpr auto MAX_EXTENT { static_cast<std::uint32_t>(std::numeric_limits<GLsizei>::max()) };
+        if (width == 0 || height == 0 || width > MAX_EXTENT || height > MAX_EXTENT) {
+            return false;
+        }
+        std::uint32_t fullChain { 1 };
+        for (std::uint32_t size = std::max(width, height); size > 1; size /= 2) {
+            ++fullChain;
+        }
+        return levelCount <= fullChain;
+    }
+
+    template <typename T>
+    bool readAt(const std::vector<GLubyte>& file, const std::size_t offset, T& value) {
+        if (offset > file.size() || file.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, file.data() + offset, sizeof(T));
+        return true;
+    }
+
+    template <typename T>
+    void append(std::vector<GLubyte>& bytes, const T& value) {
+        const std::size_t offset { bytes.size() };
+        bytes.resize(offset + sizeof(T));
+        std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+}
+
+CompressedImage::CompressedImage(const GLenum internalFormat, std::vector<GLubyte> data, std::vector<Level> levels)
+    : m_data(std::move(data)), m_levels(std::move(levels)), m_internalFormat(internalFormat) {}
+
+GLsizei CompressedImage::blockBytes(const GLenum internalFormat) {
+    const FormatInfo* info { formatInfo(internalFormat) };
+    return info ? info->blockBytes : 0;
+}
+
+std::size_t CompressedImage::levelBytes(const GLenum internalFormat, const GLsizei width, const GLsizei height) {
+    const auto blocksWide { static_cast<std::size_t>((width + 3) / 4) };
+    const auto blocksHigh { static_cast<std::size_t>((height + 3) / 4) };
+    return blocksWide * blocksHigh * static_cast<std::size_t>(blockBytes(internalFormat));
+}
+
+bool CompressedImage::isCompressedPath(const std::string& path) {
+    const auto endsWith { [&path](const std::string_view suffix) {
+        return path.size() >= suffix.size()
+            && std::equal(suffix.rbegin(), suffix.rend(), path.rbegin(), [](const char a, const char b) {
+                return a == std::tolower(static_cast<unsigned char>(b));
+            });
+    } };
+    return endsWith(".ktx2") || endsWith(".dds");
+}
+
+CompressedImage CompressedImage::load(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::FILE_NOT_SUCCESSFULLY_READ: " << path << std::endl;
+        return {};
+    }
+    const std::vector<GLubyte> file { std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+
+    CompressedImage image;
+    const bool parsed { file.size() >= KTX2_IDENTIFIER.size()
+        && std::equal(KTX2_IDENTIFIER.begin(), KTX2_IDENTIFIER.end(), file.begin())
+            ? image.parseKTX2(file, path)
+            : image.parseDDS(file, path) };
+    return parsed ? image : CompressedImage {};
+}
+
+bool CompressedImage::parseKTX2(const std::vector<GLubyte>& file, const std::string& path) {
+    KTX2Header header {};
+    if (!readAt(file, KTX2_IDENTIFIER.size(), header)) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::TRUNCATED: " << path << std::endl;
+        return false;
+    }
+    const FormatInfo* info { findFormat([&header](const FormatInfo& format) {
+        return format.vkFormat != 0 && format.vkFormat == header.vkFormat;
+    }) };
+    if (!info) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::UNSUPPORTED_FORMAT: vkFormat " << header.vkFormat << " in " << path
+                  << std::endl;
+        return false;
+    }
+    const std::uint32_t levelCount { std::max(header.levelCount, 1u) };
+    if (header.supercompressionScheme != 0 || header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1
+        || !isValidExtent(header.pixelWidth, header.pixelHeight, levelCount)) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::NOT_A_PLAIN_2D_TEXTURE: " << path << std::endl;
+        return false;
+    }
+
+    // Level 0 first in the index; the data itself is stored smallest level first.
+    constexpr std::size_t LEVEL_INDEX_OFFSET { KTX2_IDENTIFIER.size() + sizeof(KTX2Header)
+        + sizeof(KTX2SupercompressionIndex) };
+    auto width { static_cast<GLsizei>(header.pixelWidth) };
+    auto height { static_cast<GLsizei>(header.pixelHeight) };
+    for (std::uint32_t i = 0; i < levelCount; ++i) {
+        KTX2LevelIndex level {};
+        const std::size_t expected { levelBytes(info->internalFormat, width, height) };
+        if (!readAt(file, LEVEL_INDEX_OFFSET + i * sizeof(KTX2LevelIndex), level) || level.byteLength != expected
+            || level.byteOffset > file.size() || file.size() - level.byteOffset < level.byteLength) {
+            std::cout << "ERROR::COMPRESSED_IMAGE::BAD_LEVEL_INDEX: level " << i << " of " << path << std::endl;
+            return false;
+        }
+        m_levels.push_back({ width, height, m_data.size(), expected });
+        const auto begin { file.begin() + static_cast<std::ptrdiff_t>(level.byteOffset) };
+        m_data.insert(m_data.end(), begin, begin + static_cast<std::ptrdiff_t>(expected));
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    m_internalFormat = info->internalFormat;
+    return true;
+}
+
+bool CompressedImage::parseDDS(const std::vector<GLubyte>& file, const std::string& path) {
+    std::uint32_t magic {};
+    DDSHeader header {};
+    if (!readAt(file, 0, magic) || magic != DDS_MAGIC || !readAt(file, sizeof(magic), header)
+        || header.size != DDS_HEADER_SIZE) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::NOT_KTX2_OR_DDS: " << path << std::endl;
+        return false;
+    }
+    if (!(header.pixelFormatFlags & DDPF_FOURCC)) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::UNCOMPRESSED_DDS: " << path << std::endl;
+        return false;
+    }
+
+    std::size_t offset { sizeof(magic) + sizeof(DDSHeader) };
+    const FormatInfo* info {};
+    if (header.fourCC == fourCC("DX10")) {
+        DDSHeaderDX10 extended {};
+        if (!readAt(file, offset, extended)) {
+            std::cout << "ERROR::COMPRESSED_IMAGE::TRUNCATED: " << path << std::endl;
+            return false;
+        }
+        if (extended.resourceDimension != DDS_DIMENSION_TEXTURE2D || extended.arraySize > 1
+            || extended.miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) {
+            std::cout << "ERROR::COMPRESSED_IMAGE::NOT_A_PLAIN_2D_TEXTURE: " << path << std::endl;
+            return false;
+        }
+        offset += sizeof(DDSHeaderDX10);
+        info = findFormat([&extended](const FormatInfo& format) {
+            return format.dxgiFormat != 0 && format.dxgiFormat == extended.dxgiFormat;
+        });
+    } else if (const GLenum format { ddsFourCCFormat(header.fourCC) }) {
+        info = formatInfo(format);
+    }
+    if (!info) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::UNSUPPORTED_FORMAT: " << path << std::endl;
+        return false;
+    }
+
+    // Levels follow each other, largest first.
+    const std::uint32_t levelCount { header.flags & DDSD_MIPMAPCOUNT ? std::max(header.mipMapCount, 1u) : 1u };
+    if (!isValidExtent(header.width, header.height, levelCount)) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::NOT_A_PLAIN_2D_TEXTURE: " << path << std::endl;
+        return false;
+    }
+    auto width { static_cast<GLsizei>(header.width) };
+    auto height { static_cast<GLsizei>(header.height) };
+    for (std::uint32_t i = 0; i < levelCount; ++i) {
+        const std::size_t size { levelBytes(info->internalFormat, width, height) };
+        if (offset > file.size() || file.size() - offset < size) {
+            std::cout << "ERROR::COMPRESSED_IMAGE::TRUNCATED: " << path << std::endl;
+            return false;
+        }
+        m_levels.push_back({ width, height, offset, size });
+        offset += size;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    const std::size_t first { m_levels.front().offset };
+    m_data.assign(file.begin() + static_cast<std::ptrdiff_t>(first), file.begin() + static_cast<std::ptrdiff_t>(offset));
+    for (Level& level : m_levels) {
+        level.offset -= first;
+    }
+    m_internalFormat = info->internalFormat;
+    return true;
+}
+
+bool CompressedImage::writeKTX2(const std::string& path) const {
+    const FormatInfo* info { formatInfo(m_internalFormat) };
+    if (!info || m_levels.empty()) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::UNSUPPORTED_FORMAT: " << path << std::endl;
+        return false;
+    }
+
+    // Data format descriptor: one basic block describing the compressed block's channels.
+    std::vector<GLubyte> descriptor;
+    const std::uint32_t basicBlockSize { 24u + 16u * info->sampleCount };
+    append(descriptor, 4u + basicBlockSize);
+    append(descriptor, std::uint32_t { 0 });                    // Khronos vendor, basic descriptor type.
+    append(descriptor, 2u | basicBlockSize << 16);              // Version 2, block size.
+    append(descriptor, std::array<std::uint8_t, 4> {
+        info->colorModel, 1, static_cast<std::uint8_t>(info->srgb ? 2 : 1), 0 }); // BT.709 primaries.
+    append(descriptor, std::array<std::uint8_t, 4> { 3, 3, 0, 0 });              // 4x4 texel blocks.
+    append(descriptor, std::array<std::uint8_t, 8> { static_cast<std::uint8_t>(info->blockBytes) });
+    // The samples split the block evenly: 64 bits each, or all 128 for a single BC6H/BC7 sample.
+    const auto bitLength { static_cast<std::uint8_t>(info->blockBytes * 8 / info->sampleCount - 1) }; // Minus one.
+    for (std::uint8_t i = 0; i < info->sampleCount; ++i) {
+        const Sample& sample { info->samples[i] };
+        append(descriptor, sample.bitOffset);
+        append(descriptor, bitLength);
+        append(descriptor, static_cast<std::uint8_t>(sample.channel | info->qualifiers));
+        append(descriptor, std::uint32_t { 0 });                 // Sample position.
+        const bool isSigned { (info->qualifiers & CHANNEL_SIGNED) != 0 };
+        const bool isFloat { (info->qualifiers & CHANNEL_FLOAT) != 0 };
+        append(descriptor, isFloat ? 0xBF800000u : isSigned ? 0x80000000u : 0u);
+        append(descriptor, isFloat ? 0x3F800000u : isSigned ? 0x7FFFFFFFu : 0xFFFFFFFFu);
+    }
+
+    const std::size_t levelIndexOffset { KTX2_IDENTIFIER.size() + sizeof(KTX2Header)
+        + sizeof(KTX2SupercompressionIndex) };
+    const std::size_t descriptorOffset { levelIndexOffset + m_levels.size() * sizeof(KTX2LevelIndex) };
+    const auto alignment { static_cast<std::size_t>(info->blockBytes) };
+    auto alignUp { [alignment](const std::size_t value) { return (value + alignment - 1) / alignment * alignment; } };
+
+    // Smallest level first, each aligned to the block size.
+    std::vector<KTX2LevelIndex> levelIndex(m_levels.size());
+    std::size_t cursor { descriptorOffset + descriptor.size() };
+    for (std::size_t i = m_levels.size(); i-- > 0;) {
+        cursor = alignUp(cursor);
+        levelIndex[i] = { cursor, m_levels[i].size, m_levels[i].size };
+        cursor += m_levels[i].size;
+    }
+
+    const KTX2Header header {
+        info->vkFormat, 1, static_cast<std::uint32_t>(m_levels[0].width),
+        static_cast<std::uint32_t>(m_levels[0].height), 0, 0, 1, static_cast<std::uint32_t>(m_levels.size()), 0,
+        static_cast<std::uint32_t>(descriptorOffset), static_cast<std::uint32_t>(descriptor.size()), 0, 0
+    };
+
+    std::vector<GLubyte> bytes(KTX2_IDENTIFIER.begin(), KTX2_IDENTIFIER.end());
+    append(bytes, header);
+    append(bytes, KTX2SupercompressionIndex {});
+    for (const KTX2LevelIndex& level : levelIndex) {
+        append(bytes, level);
+    }
+    bytes.insert(bytes.end(), descriptor.begin(), descriptor.end());
+    for (std::size_t i = m_levels.size(); i-- > 0;) {
+        bytes.resize(levelIndex[i].byteOffset);
+        const auto begin { m_data.begin() + static_cast<std::ptrdiff_t>(m_levels[i].offset) };
+        bytes.insert(bytes.end(), begin, begin + static_cast<std::ptrdiff_t>(m_levels[i].size));
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        std::cout << "ERROR::COMPRESSED_IMAGE::WRITE_FAILED: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
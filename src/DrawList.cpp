@@ -0,0 +1,79 @@
+#include "DrawList.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+DrawList::DrawList(const std::size_t capacity) : m_capacity(std::max<std::size_t>(capacity, 1)) {
+    if (!isSupported()) {
+        std::cout << "ERROR::DRAW_LIST::NEEDS_BASE_INSTANCE: per-draw data needs a GL 4.2 context" << std::endl;
+        return;
+    }
+    m_commands.reserve(m_capacity);
+    if (GLAD_GL_VERSION_4_3) {
+        m_indirect = std::make_unique<StreamBuffer>(GL_DRAW_INDIRECT_BUFFER,
+            static_cast<GLsizeiptr>(m_capacity * sizeof(DrawElementsIndirectCommand)));
+    }
+}
+
+bool DrawList::isSupported() {
+    return GLAD_GL_VERSION_4_2 != 0;
+}
+
+GLuint DrawList::add(const MeshArena::Mesh& mesh, const GLuint instanceCount) {
+    const GLuint baseInstance { m_instanceCount };
+    add(mesh, instanceCount, baseInstance);
+    m_instanceCount += instanceCount;
+    return baseInstance;
+}
+
+void DrawList::add(const MeshArena::Mesh& mesh, const GLuint instanceCount, const GLuint baseInstance) {
+    if (!isSupported()) {
+        return;
+    }
+    m_commands.push_back({ mesh.indexCount, instanceCount, mesh.firstIndex, mesh.baseVertex, baseInstance });
+}
+
+void DrawList::clear() {
+    m_commands.clear();
+    m_instanceCount = 0;
+}
+
+void DrawList::submit(const MeshArena& arena, const GLenum mode) {
+    if (m_commands.empty()) {
+        return;
+    }
+    arena.getVAO().bind();
+    const GLenum indexType { arena.getIndexType() };
+
+    if (m_indirect) {
+        const auto size { static_cast<GLsizeiptr>(m_commands.size() * sizeof(DrawElementsIndirectCommand)) };
+        const StreamBuffer::Allocation allocation { m_indirect->allocate(size) };
+        if (allocation.data) {
+            std::memcpy(allocation.data, m_commands.data(), static_cast<std::size_t>(size));
+            m_indirect->flush();
+            m_indirect->bind();
+            glMultiDrawElementsIndirect(mode, indexType, reinterpret_cast<const void*>(allocation.offset),
+                static_cast<GLsizei>(m_commands.size()), 0);
+            ++m_drawCalls;
+            return;
+        }
+        // More commands this frame than the capacity covers: still drawn, one call each.
+    }
+
+    const auto indexSize { static_cast<std::size_t>(EBO::indexSize(indexType)) };
+    for (const DrawElementsIndirectCommand& command : m_commands) {
+        const void* offset { reinterpret_cast<const void*>(command.firstIndex * indexSize) };
+        const auto count { static_cast<GLsizei>(command.count) };
+        const auto instances { static_cast<GLsizei>(command.instanceCount) };
+        glDrawElementsInstancedBaseVertexBaseInstance(mode, count, indexType, offset, instances, command.baseVertex,
+            command.baseInstance);
+        ++m_drawCalls;
+    }
+}
+
+void DrawList::endFrame() {
+    if (m_indirect) {
+        m_indirect->endFrame();
+    }
+    m_drawCalls = 0;
+}
@@ -2,8 +2,45 @@
 // Created by Keal on 4/13/2026.
 //
 #include "EBO.hpp"
+#include "GLStateCache.hpp"
+#include "GLCapabilities.hpp"
+#include <algorithm>
+#include <vector>
 
 EBO::EBO(const GLuint *indices, const GLsizeiptr size) {
+    m_count = static_cast<GLsizei>(size / static_cast<GLsizeiptr>(sizeof(GLuint)));
+    const GLuint* end { indices + m_count };
+    // Restart markers become 0xFFFF; every other index must stay below it.
+    const bool fitsShort { std::all_of(indices, end, [](const GLuint index) {
+        return index < 0xFFFF || index == RESTART_INDEX;
+    }) };
+    if (!fitsShort) {
+        m_indexType = GL_UNSIGNED_INT;
+        create(indices, size);
+        return;
+    }
+    std::vector<GLushort> narrowed(indices, end);
+    m_indexType = GL_UNSIGNED_SHORT;
+    create(narrowed.data(), static_cast<GLsizeiptr>(narrowed.size() * sizeof(GLushort)));
+}
+
+EBO::EBO(const GLushort *indices, const GLsizeiptr size)
+    : m_indexType(GL_UNSIGNED_SHORT), m_count(static_cast<GLsizei>(size / static_cast<GLsizeiptr>(sizeof(GLushort)))) {
+    create(indices, size);
+}
+
+EBO::EBO(const GLubyte *indices, const GLsizeiptr size)
+    : m_indexType(GL_UNSIGNED_BYTE), m_count(static_cast<GLsizei>(size)) {
+    create(indices, size);
+}
+
+void EBO::create(const void *indices, const GLsizeiptr size) {
+    if (GLCapabilities::hasDirectStateAccess()) {
+        // Immutable storage filled once, without touching any binding.
+        glCreateBuffers(1, &m_ID);
+        glNamedBufferStorage(m_ID, size, indices, 0);
+        return;
+    }
     glGenBuffers(1, &m_ID);
     bind();
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
@@ -11,12 +48,35 @@ EBO::EBO(const GLuint *indices, const GLsizeiptr size) {
 
 EBO::~EBO() {
     glDeleteBuffers(1, &m_ID);
+    GLStateCache::onBufferDeleted(m_ID);
 }
 
 void EBO::bind() const {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ID);
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ID);
 }
 
 void EBO::unbind(){
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-}
\ No newline at end of file
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+GLsizei EBO::indexSize(const GLenum indexType) {
+    switch (indexType) {
+        case GL_UNSIGNED_BYTE:
+            return 1;
+        case GL_UNSIGNED_SHORT:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+GLuint EBO::restartIndex(const GLenum indexType) {
+    switch (indexType) {
+        case GL_UNSIGNED_BYTE:
+            return 0xFF;
+        case GL_UNSIGNED_SHORT:
+            return 0xFFFF;
+        default:
+            return RESTART_INDEX;
+    }
+}
@@ -0,0 +1,239 @@
+#include "FrameBenchmark.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <type_traits>
+
+namespace {
+    enum Counter { DRAW_CALLS, STATE_CHANGES, UNIFORM_UPDATES, COUNTER_COUNT };
+    std::array<std::uint64_t, COUNTER_COUNT> g_counters {};
+
+    // Swaps a glad function pointer for a wrapper that bumps a counter and forwards the call.
+    template <auto& Function, Counter C, typename Signature = std::remove_reference_t<decltype(Function)>>
+    struct CountedCall;
+
+    template <auto& Function, Counter C, typename R, typename... Args>
+    struct CountedCall<Function, C, R (APIENTRYP)(Args...)> {
+        static inline R (APIENTRYP original)(Args...) {};
+
+        static R APIENTRY call(Args... args) {
+            ++g_counters[C];
+            return original(args...);
+        }
+
+        static void install() {
+            if (Function && Function != &call) {
+                original = Function;
+                Function = &call;
+            }
+        }
+    };
+
+    template <auto&... Functions>
+    void countDraws() {
+        (CountedCall<Functions, DRAW_CALLS>::install(), ...);
+    }
+
+    template <auto&... Functions>
+    void countStateChanges() {
+        (CountedCall<Functions, STATE_CHANGES>::install(), ...);
+    }
+
+    template <auto&... Functions>
+    void countUniformUpdates() {
+        (CountedCall<Functions, UNIFORM_UPDATES>::install(), ...);
+    }
+
+    void installCounters() {
+        countDraws<glad_glDrawArrays, glad_glDrawElements, glad_glDrawRangeElements,
+                   glad_glDrawArraysInstanced, glad_glDrawElementsInstanced,
+                   glad_glDrawElementsBaseVertex, glad_glDrawElementsInstancedBaseVertex,
+                   glad_glDrawElementsInstancedBaseVertexBaseInstance,
+                   glad_glMultiDrawArrays, glad_glMultiDrawElements,
+                   glad_glDrawArraysIndirect, glad_glDrawElementsIndirect,
+                   glad_glMultiDrawArraysIndirect, glad_glMultiDrawElementsIndirect>();
+
+        countStateChanges<glad_glUseProgram, glad_glBindVertexArray, glad_glBindBuffer,
+                          glad_glBindBufferBase, glad_glBindBufferRange, glad_glBindTexture,
+                          glad_glActiveTexture, glad_glBindSampler, glad_glBindFramebuffer,
+                          glad_glEnable, glad_glDisable, glad_glBlendFunc, glad_glBlendFuncSeparate,
+                          glad_glPolygonMode, glad_glViewport, glad_glScissor, glad_glDepthFunc,
+                          glad_glDepthMask, glad_glCullFace>();
+
+        countUniformUpdates<glad_glUniform1i, glad_glUniform1f, glad_glUniform2f, glad_glUniform3f,
+                            glad_glUniform4f, glad_glUniform1iv, glad_glUniform1fv, glad_glUniform2fv,
+                            glad_glUniform3fv, glad_glUniform4fv, glad_glUniformMatrix3fv,
+                            glad_glUniformMatrix4fv>();
+    }
+
+    double percentile(std::vector<double> samples, const double p) {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        std::sort(samples.begin(), samples.end());
+        // Nearest-rank percentile.
+        const auto rank { static_cast<std::size_t>(p / 100.0 * static_cast<double>(samples.size()) + 0.999999) };
+        return samples[std::clamp<std::size_t>(rank, 1, samples.size()) - 1];
+    }
+
+    void writeDistribution(std::ofstream& out, const char* name, const std::vector<double>& samples) {
+        const double mean { samples.empty() ? 0.0
+            : std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size()) };
+        const double max { samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end()) };
+        out << "  \"" << name << "\": { \"samples\": " << samples.size()
+            << ", \"mean\": " << mean
+            << ", \"p50\": " << percentile(samples, 50.0)
+            << ", \"p95\": " << percentile(samples, 95.0)
+            << ", \"p99\": " << percentile(samples, 99.0)
+            << ", \"max\": " << max << " }";
+    }
+
+    std::string escapeJson(const std::string& text) {
+        std::string escaped;
+        for (const char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                // JSON strings can't hold raw control characters.
+                char code[7];
+                std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+                escaped += code;
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    std::string glString(const GLenum name) {
+        const auto* value { reinterpret_cast<const char*>(glGetString(name)) };
+        return value ? value : "";
+    }
+}
+
+FrameBenchmark::FrameBenchmark(std::string scene, std::string outputPath, const long long warmupFrames,
+    const long long measuredFrames)
+    : m_scene(std::move(scene)), m_outputPath(std::move(outputPath)),
+      m_warmupFrames(warmupFrames), m_measuredFrames(measuredFrames) {
+    installCounters();
+    glGenQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+
+    m_cpuFrameMs.reserve(static_cast<std::size_t>(m_measuredFrames));
+    m_gpuFrameMs.reserve(static_cast<std::size_t>(m_measuredFrames));
+    m_counters.reserve(static_cast<std::size_t>(m_measuredFrames));
+
+    beginFrame();
+}
+
+FrameBenchmark::~FrameBenchmark() {
+    glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+}
+
+std::unique_ptr<FrameBenchmark> FrameBenchmark::createFromEnvironment(const char* fallbackScene) {
+    const char* output { std::getenv("COREGL_BENCH_OUTPUT") };
+    if (!output || !*output) {
+        return nullptr;
+    }
+    const char* scene { std::getenv("COREGL_BENCH_SCENE") };
+    const char* frames { std::getenv("COREGL_BENCH_FRAMES") };
+    const char* warmup { std::getenv("COREGL_BENCH_WARMUP") };
+
+    return std::make_unique<FrameBenchmark>(scene && *scene ? scene : fallbackScene, output,
+                                            warmup ? std::max(0LL, std::atoll(warmup)) : 30,
+                                            frames ? std::max(1LL, std::atoll(frames)) : 300);
+}
+
+void FrameBenchmark::endFrame() {
+    if (m_queryActive) {
+        glEndQuery(GL_TIME_ELAPSED);
+        m_queryActive = false;
+        ++m_queriesPending;
+    }
+}
+
+void FrameBenchmark::beginFrame() {
+    const auto now { std::chrono::steady_clock::now() };
+    // m_frameIndex is the 1-based frame that just ended (0 before the first one has started).
+    const long long measuredIndex { m_frameIndex - 1 - m_warmupFrames };
+    if (measuredIndex >= 0 && measuredIndex < m_measuredFrames) {
+        m_cpuFrameMs.push_back(std::chrono::duration<double, std::milli>(now - m_frameStart).count());
+        m_counters.push_back({ g_counters[DRAW_CALLS], g_counters[STATE_CHANGES], g_counters[UNIFORM_UPDATES] });
+    }
+    g_counters.fill(0);
+    m_frameStart = now;
+    ++m_frameIndex;
+
+    collectQueries(m_queriesPending == m_queries.size());
+    const std::size_t slot { (m_queryHead + m_queriesPending) % m_queries.size() };
+    m_queryFrame[slot] = m_frameIndex;
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[slot]);
+    m_queryActive = true;
+}
+
+void FrameBenchmark::collectQueries(bool wait) {
+    while (m_queriesPending > 0) {
+        const GLuint query { m_queries[m_queryHead] };
+        if (!wait) {
+            GLint available {};
+            glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                return;
+            }
+        }
+        GLuint64 elapsedNs {};
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+
+        const long long measuredIndex { m_queryFrame[m_queryHead] - 1 - m_warmupFrames };
+        if (measuredIndex >= 0 && measuredIndex < m_measuredFrames) {
+            m_gpuFrameMs.push_back(static_cast<double>(elapsedNs) / 1.0e6);
+        }
+        m_queryHead = (m_queryHead + 1) % m_queries.size();
+        --m_queriesPending;
+        wait = false; // Only block for the oldest query, the rest are usually ready by then.
+    }
+}
+
+void FrameBenchmark::writeReport() {
+    if (m_reportWritten) {
+        return;
+    }
+    m_reportWritten = true;
+
+    endFrame();
+    collectQueries(true);
+
+    std::vector<double> drawCalls, stateChanges, uniformUpdates;
+    for (const FrameCounters& counters : m_counters) {
+        drawCalls.push_back(static_cast<double>(counters.drawCalls));
+        stateChanges.push_back(static_cast<double>(counters.stateChanges));
+        uniformUpdates.push_back(static_cast<double>(counters.uniformUpdates));
+    }
+
+    std::ofstream out(m_outputPath);
+    if (!out) {
+        std::cout << "ERROR::BENCHMARK::CANNOT_WRITE_REPORT: " << m_outputPath << std::endl;
+        return;
+    }
+    out << "{\n"
+        << "  \"scene\": \"" << escapeJson(m_scene) << "\",\n"
+        << "  \"renderer\": \"" << escapeJson(glString(GL_RENDERER)) << "\",\n"
+        << "  \"version\": \"" << escapeJson(glString(GL_VERSION)) << "\",\n"
+        << "  \"warmup_frames\": " << m_warmupFrames << ",\n"
+        << "  \"measured_frames\": " << m_cpuFrameMs.size() << ",\n";
+    writeDistribution(out, "cpu_frame_ms", m_cpuFrameMs);
+    out << ",\n";
+    writeDistribution(out, "gpu_frame_ms", m_gpuFrameMs);
+    out << ",\n";
+    writeDistribution(out, "draw_calls", drawCalls);
+    out << ",\n";
+    writeDistribution(out, "state_changes", stateChanges);
+    out << ",\n";
+    writeDistribution(out, "uniform_updates", uniformUpdates);
+    out << "\n}\n";
+
+    std::cout << "Benchmark report written to " << m_outputPath << std::endl;
+}
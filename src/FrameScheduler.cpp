@@ -0,0 +1,71 @@
+#include "FrameScheduler.hpp"
+#include <algorithm>
+#include <thread>
+
+void FrameScheduler::beginFrame() {
+    const Clock::time_point now { Clock::now() };
+    if (!m_started) {
+        m_started = true;
+        m_startTime = now;
+        m_frameStart = now;
+        return;
+    }
+
+    m_delta = now - m_frameStart;
+    m_frameStart = now;
+
+    const double deltaSeconds { getDeltaSeconds() };
+    m_smoothedDeltaSeconds = m_smoothedDeltaSeconds == 0.0
+        ? deltaSeconds
+        : m_smoothedDeltaSeconds + m_smoothingFactor * (deltaSeconds - m_smoothedDeltaSeconds);
+
+    m_accumulator = std::min(m_accumulator + m_delta, m_fixedStep * m_maxStepsPerFrame);
+    m_stepsThisFrame = 0;
+}
+
+bool FrameScheduler::stepFixedUpdate() {
+    if (m_accumulator < m_fixedStep || m_stepsThisFrame >= m_maxStepsPerFrame) {
+        return false;
+    }
+    m_accumulator -= m_fixedStep;
+    ++m_stepsThisFrame;
+    return true;
+}
+
+void FrameScheduler::waitForNextFrame() const {
+    if (m_targetFrameTime <= Nanoseconds::zero() || !m_started) {
+        return;
+    }
+    const Clock::time_point deadline { m_frameStart + m_targetFrameTime };
+
+    // sleep_for may overshoot by the scheduler quantum, so stop sleeping early and spin the rest.
+    const Clock::time_point sleepUntil { deadline - m_spinTime };
+    if (const Clock::time_point now { Clock::now() }; now < sleepUntil) {
+        std::this_thread::sleep_for(sleepUntil - now);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void FrameScheduler::setFixedStep(const Nanoseconds step) {
+    m_fixedStep = std::max(step, Nanoseconds(1));
+}
+
+void FrameScheduler::setMaxStepsPerFrame(const int steps) {
+    m_maxStepsPerFrame = std::max(steps, 1);
+}
+
+void FrameScheduler::setTargetFrameRate(const double framesPerSecond) {
+    m_targetFrameTime = framesPerSecond > 0.0
+        ? std::chrono::duration_cast<Nanoseconds>(std::chrono::duration<double>(1.0 / framesPerSecond))
+        : Nanoseconds::zero();
+}
+
+void FrameScheduler::setSpinTime(const Nanoseconds spinTime) {
+    m_spinTime = std::max(spinTime, Nanoseconds::zero());
+}
+
+void FrameScheduler::setSmoothingFactor(const double alpha) {
+    m_smoothingFactor = std::clamp(alpha, 0.001, 1.0);
+}
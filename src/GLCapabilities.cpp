@@ -0,0 +1,111 @@
+#include "GLCapabilities.hpp"
+#include "Hash.hpp"
+#include <cstdlib>
+
+std::unordered_set<std::uint64_t> GLCapabilities::s_extensions;
+GLCapabilities::MaxShaderCompilerThreadsProc GLCapabilities::s_maxShaderCompilerThreads { nullptr };
+GLCapabilities::GetTextureHandleProc GLCapabilities::s_getTextureHandle { nullptr };
+GLCapabilities::TextureHandleProc GLCapabilities::s_makeTextureHandleResident { nullptr };
+GLCapabilities::TextureHandleProc GLCapabilities::s_makeTextureHandleNonResident { nullptr };
+bool GLCapabilities::s_directStateAccess { false };
+
+void GLCapabilities::load(const GLADloadproc loader) {
+    s_extensions.clear();
+    GLint extensionCount {};
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; ++i) {
+        const auto* name { reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i))) };
+        if (name) {
+            s_extensions.insert(fnv1a64(std::string_view(name)));
+        }
+    }
+
+    s_directStateAccess = GLAD_GL_VERSION_4_5 && !std::getenv("COREGL_NO_DSA");
+
+    s_maxShaderCompilerThreads = nullptr;
+    if (hasExtension("GL_KHR_parallel_shader_compile")) {
+        s_maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(loader("glMaxShaderCompilerThreadsKHR"));
+    } else if (hasExtension("GL_ARB_parallel_shader_compile")) {
+        s_maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(loader("glMaxShaderCompilerThreadsARB"));
+    }
+
+    s_getTextureHandle = nullptr;
+    s_makeTextureHandleResident = nullptr;
+    s_makeTextureHandleNonResident = nullptr;
+    if (hasExtension("GL_ARB_bindless_texture")) {
+        s_makeTextureHandleResident = reinterpret_cast<TextureHandleProc>(loader("glMakeTextureHandleResidentARB"));
+        s_makeTextureHandleNonResident = reinterpret_cast<TextureHandleProc>(loader("glMakeTextureHandleNonResidentARB"));
+        if (s_makeTextureHandleResident && s_makeTextureHandleNonResident) {
+            s_getTextureHandle = reinterpret_cast<GetTextureHandleProc>(loader("glGetTextureHandleARB"));
+        }
+    }
+}
+
+bool GLCapabilities::hasExtension(const std::string_view name) {
+    return s_extensions.contains(fnv1a64(name));
+}
+
+bool GLCapabilities::hasParallelShaderCompile() {
+    return s_maxShaderCompilerThreads != nullptr;
+}
+
+bool GLCapabilities::hasCompressedFormat(const GLenum internalFormat) {
+    switch (internalFormat) {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            return hasExtension("GL_EXT_texture_compression_s3tc");
+        case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+            return hasExtension("GL_EXT_texture_compression_s3tc")
+                && (hasExtension("GL_EXT_texture_sRGB") || hasExtension("GL_EXT_texture_compression_s3tc_srgb"));
+        case GL_COMPRESSED_RED_RGTC1:
+        case GL_COMPRESSED_SIGNED_RED_RGTC1:
+        case GL_COMPRESSED_RG_RGTC2:
+        case GL_COMPRESSED_SIGNED_RG_RGTC2:
+            return true;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+        case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+            return GLAD_GL_VERSION_4_2 || hasExtension("GL_ARB_texture_compression_bptc");
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_SRGB8_ETC2:
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+        case GL_COMPRESSED_R11_EAC:
+        case GL_COMPRESSED_SIGNED_R11_EAC:
+        case GL_COMPRESSED_RG11_EAC:
+        case GL_COMPRESSED_SIGNED_RG11_EAC:
+            return GLAD_GL_VERSION_4_3 || hasExtension("GL_ARB_ES3_compatibility");
+        default:
+            return false;
+    }
+}
+
+GLuint64 GLCapabilities::getTextureHandle(const GLuint texture) {
+    return s_getTextureHandle ? s_getTextureHandle(texture) : 0;
+}
+
+void GLCapabilities::makeTextureHandleResident(const GLuint64 handle) {
+    if (s_makeTextureHandleResident) {
+        s_makeTextureHandleResident(handle);
+    }
+}
+
+void GLCapabilities::makeTextureHandleNonResident(const GLuint64 handle) {
+    if (s_makeTextureHandleNonResident) {
+        s_makeTextureHandleNonResident(handle);
+    }
+}
+
+void GLCapabilities::setMaxShaderCompilerThreads(const GLuint count) {
+    if (s_maxShaderCompilerThreads) {
+        s_maxShaderCompilerThreads(count);
+    }
+}
@@ -0,0 +1,262 @@
+#include "GLStateCache.hpp"
+#include "EBO.hpp"
+#include <numeric>
+
+GLStateCache::State GLStateCache::s_state { makeUnknownState() };
+GLStateCache::Counters GLStateCache::s_counters {};
+
+std::uint64_t GLStateCache::Counters::totalIssued() const {
+    return std::accumulate(issued.begin(), issued.end(), std::uint64_t {});
+}
+
+std::uint64_t GLStateCache::Counters::totalSkipped() const {
+    return std::accumulate(skipped.begin(), skipped.end(), std::uint64_t {});
+}
+
+GLStateCache::State GLStateCache::makeUnknownState() {
+    State state {};
+    state.buffers.fill(UNKNOWN);
+    for (auto& target : state.indexedBuffers) {
+        target.fill(UNKNOWN);
+    }
+    for (auto& unit : state.textures) {
+        unit.fill(UNKNOWN);
+    }
+    state.blendFunc.fill(UNKNOWN);
+    return state;
+}
+
+void GLStateCache::invalidate() {
+    s_state = makeUnknownState();
+}
+
+void GLStateCache::resetCounters() {
+    s_counters = {};
+}
+
+int GLStateCache::bufferTargetIndex(const GLenum target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER:          return 0;
+        case GL_ELEMENT_ARRAY_BUFFER:  return 1;
+        case GL_PIXEL_UNPACK_BUFFER:   return 2;
+        case GL_PIXEL_PACK_BUFFER:     return 3;
+        case GL_UNIFORM_BUFFER:        return 4;
+        case GL_SHADER_STORAGE_BUFFER: return 5;
+        case GL_DRAW_INDIRECT_BUFFER:  return 6;
+        case GL_COPY_READ_BUFFER:      return 7;
+        case GL_COPY_WRITE_BUFFER:     return 8;
+        case GL_TEXTURE_BUFFER:        return 9;
+        default:                       return -1;
+    }
+}
+
+int GLStateCache::textureTargetIndex(const GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D:       return 0;
+        case GL_TEXTURE_2D_ARRAY: return 1;
+        case GL_TEXTURE_CUBE_MAP: return 2;
+        case GL_TEXTURE_3D:       return 3;
+        case GL_TEXTURE_1D:       return 4;
+        default:                  return -1;
+    }
+}
+
+int GLStateCache::indexedTargetIndex(const GLenum target) {
+    switch (target) {
+        case GL_UNIFORM_BUFFER:        return 0;
+        case GL_SHADER_STORAGE_BUFFER: return 1;
+        default:                       return -1;
+    }
+}
+
+bool GLStateCache::changes(const Kind kind, const bool differs) {
+    const auto index { static_cast<std::size_t>(kind) };
+    if (differs) {
+        ++s_counters.issued[index];
+    } else {
+        ++s_counters.skipped[index];
+    }
+    return differs;
+}
+
+// --- Bindings ---
+void GLStateCache::useProgram(const GLuint program) {
+    if (changes(Kind::Program, s_state.program != program)) {
+        glUseProgram(program);
+        s_state.program = program;
+    }
+}
+
+void GLStateCache::bindVertexArray(const GLuint vertexArray) {
+    if (changes(Kind::VertexArray, s_state.vertexArray != vertexArray)) {
+        glBindVertexArray(vertexArray);
+        s_state.vertexArray = vertexArray;
+        s_state.buffers[bufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN; // Stored in the VAO.
+    }
+}
+
+void GLStateCache::bindBuffer(const GLenum target, const GLuint buffer) {
+    const int index { bufferTargetIndex(target) };
+    if (index < 0) {
+        changes(Kind::Buffer, true);
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (changes(Kind::Buffer, s_state.buffers[index] != buffer)) {
+        glBindBuffer(target, buffer);
+        s_state.buffers[index] = buffer;
+    }
+}
+
+void GLStateCache::bindBufferBase(const GLenum target, const GLuint index, const GLuint buffer) {
+    const int targetIndex { indexedTargetIndex(target) };
+    if (targetIndex < 0 || index >= MAX_INDEXED_BINDINGS) {
+        changes(Kind::Buffer, true);
+        glBindBufferBase(target, index, buffer);
+        const int generic { bufferTargetIndex(target) };
+        if (generic >= 0) {
+            s_state.buffers[generic] = buffer;
+        }
+        return;
+    }
+    GLuint& bound { s_state.indexedBuffers[targetIndex][index] };
+    if (changes(Kind::Buffer, bound != buffer)) {
+        glBindBufferBase(target, index, buffer);
+        bound = buffer;
+        s_state.buffers[bufferTargetIndex(target)] = buffer;
+    }
+}
+
+void GLStateCache::activeTexture(const GLenum unit) {
+    if (changes(Kind::ActiveTexture, s_state.activeTexture != unit)) {
+        glActiveTexture(unit);
+        s_state.activeTexture = unit;
+    }
+}
+
+void GLStateCache::bindTexture(const GLenum unit, const GLenum target, const GLuint texture) {
+    const auto unitIndex { static_cast<int>(unit) - GL_TEXTURE0 };
+    const int targetIndex { textureTargetIndex(target) };
+    if (unitIndex < 0 || unitIndex >= MAX_TEXTURE_UNITS || targetIndex < 0) {
+        activeTexture(unit);
+        changes(Kind::Texture, true);
+        glBindTexture(target, texture);
+        return;
+    }
+    GLuint& bound { s_state.textures[unitIndex][targetIndex] };
+    if (bound == texture) {
+        changes(Kind::Texture, false); // The unit does not even need to become active.
+        return;
+    }
+    activeTexture(unit);
+    changes(Kind::Texture, true);
+    glBindTexture(target, texture);
+    bound = texture;
+}
+
+void GLStateCache::bindTexture(const GLenum target, const GLuint texture) {
+    if (s_state.activeTexture == UNKNOWN) {
+        activeTexture(GL_TEXTURE0);
+    }
+    bindTexture(s_state.activeTexture, target, texture);
+}
+
+// --- Fixed-function state ---
+void GLStateCache::setBlend(const bool enabled) {
+    const GLint value { enabled ? GL_TRUE : GL_FALSE };
+    if (changes(Kind::Blend, s_state.blend != value)) {
+        enabled ? glEnable(GL_BLEND) : glDisable(GL_BLEND);
+        s_state.blend = value;
+    }
+}
+
+void GLStateCache::setBlendFunc(const GLenum source, const GLenum destination) {
+    setBlendFuncSeparate(source, destination, source, destination);
+}
+
+void GLStateCache::setBlendFuncSeparate(const GLenum sourceRGB, const GLenum destinationRGB,
+    const GLenum sourceAlpha, const GLenum destinationAlpha) {
+    const std::array<GLenum, 4> blendFunc { sourceRGB, destinationRGB, sourceAlpha, destinationAlpha };
+    if (changes(Kind::Blend, s_state.blendFunc != blendFunc)) {
+        glBlendFuncSeparate(sourceRGB, destinationRGB, sourceAlpha, destinationAlpha);
+        s_state.blendFunc = blendFunc;
+    }
+}
+
+void GLStateCache::setPolygonMode(const GLenum mode) {
+    if (changes(Kind::PolygonMode, s_state.polygonMode != mode)) {
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+        s_state.polygonMode = mode;
+    }
+}
+
+void GLStateCache::setViewport(const GLint x, const GLint y, const GLsizei width, const GLsizei height) {
+    const std::array<GLint, 4> viewport { x, y, width, height };
+    if (changes(Kind::Viewport, !s_state.viewportKnown || s_state.viewport != viewport)) {
+        glViewport(x, y, width, height);
+        s_state.viewport = viewport;
+        s_state.viewportKnown = true;
+    }
+}
+
+void GLStateCache::setPrimitiveRestart(const bool enabled, const GLenum indexType) {
+    const GLint value { enabled ? GL_TRUE : GL_FALSE };
+    const auto capability { static_cast<GLenum>(GLAD_GL_VERSION_4_3 ? GL_PRIMITIVE_RESTART_FIXED_INDEX : GL_PRIMITIVE_RESTART) };
+    if (changes(Kind::PrimitiveRestart, s_state.primitiveRestart != value)) {
+        enabled ? glEnable(capability) : glDisable(capability);
+        s_state.primitiveRestart = value;
+    }
+    if (!enabled || GLAD_GL_VERSION_4_3) {
+        return;
+    }
+    const GLuint index { EBO::restartIndex(indexType) };
+    if (changes(Kind::PrimitiveRestart, s_state.restartIndex != index)) {
+        glPrimitiveRestartIndex(index);
+        s_state.restartIndex = index;
+    }
+}
+
+// --- Deletion ---
+void GLStateCache::onProgramDeleted(const GLuint program) {
+    if (s_state.program == program) {
+        s_state.program = UNKNOWN;
+    }
+}
+
+void GLStateCache::onVertexArrayDeleted(const GLuint vertexArray) {
+    if (s_state.vertexArray == vertexArray) {
+        s_state.vertexArray = 0; // GL falls back to the default vertex array.
+        s_state.buffers[bufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+    }
+}
+
+void GLStateCache::onBufferDeleted(const GLuint buffer) {
+    for (GLuint& bound : s_state.buffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+    for (auto& target : s_state.indexedBuffers) {
+        for (GLuint& bound : target) {
+            if (bound == buffer) {
+                bound = 0;
+            }
+        }
+    }
+}
+
+void GLStateCache::onElementBufferChanged(const GLuint vertexArray, const GLuint buffer) {
+    if (s_state.vertexArray == vertexArray) {
+        s_state.buffers[bufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = buffer;
+    }
+}
+
+void GLStateCache::onTextureDeleted(const GLuint texture) {
+    for (auto& unit : s_state.textures) {
+        for (GLuint& bound : unit) {
+            if (bound == texture) {
+                bound = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,242 @@
+#define _USE_MATH_DEFINES
+#include "Geometry.hpp"
+#include "EBO.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    // Points handled together by arc(). Within a block every point is the block's start rotated by a fixed
+    // offset, independent of its neighbours, so the compiler vectorizes the loop.
+    constexpr std::size_t BLOCK { 8 };
+    // The block start itself advances by rotation; recomputing it exactly this often keeps the rounding
+    // error that builds up along the rim below 1e-6 of the radius.
+    constexpr std::size_t RESEED_BLOCKS { 32 };
+
+    bool checkTopology(const Geometry::Topology topology, const Geometry::Topology allowed, const char* shape) {
+        if (topology == Geometry::Topology::Triangles || topology == allowed) {
+            return true;
+        }
+        std::cout << "ERROR::GEOMETRY::UNSUPPORTED_TOPOLOGY: " << shape << std::endl;
+        return false;
+    }
+
+    bool checkCount(const int count, const int minimum, const char* what) {
+        if (count >= minimum) {
+            return true;
+        }
+        std::cout << "ERROR::GEOMETRY::TOO_FEW_" << what << ": " << count << std::endl;
+        return false;
+    }
+
+    // Indices for a center vertex followed by rimCount rim vertices.
+    void writeFanIndices(GLuint* indices, const GLuint base, const GLuint rimCount, const Geometry::Topology topology) {
+        if (topology == Geometry::Topology::Fan) {
+            *indices++ = base;
+            for (GLuint i = 1; i <= rimCount; ++i) {
+                *indices++ = base + i;
+            }
+            *indices = base + 1;
+            return;
+        }
+        for (GLuint i = 1; i < rimCount; ++i) {
+            indices[0] = base;
+            indices[1] = base + i;
+            indices[2] = base + i + 1;
+            indices += 3;
+        }
+        indices[0] = base;
+        indices[1] = base + rimCount;
+        indices[2] = base + 1;
+    }
+
+    std::size_t fanIndexCount(const std::size_t rimCount, const Geometry::Topology topology) {
+        return topology == Geometry::Topology::Fan ? rimCount + 2 : rimCount * 3;
+    }
+}
+
+void Geometry::arc(GLfloat* positions, const std::size_t stride, const std::size_t count, const glm::vec2 center,
+    const float radius, const float startAngle, const float step) {
+    float offsetCos[BLOCK];
+    float offsetSin[BLOCK];
+    for (std::size_t k = 0; k < BLOCK; ++k) {
+        offsetCos[k] = radius * static_cast<float>(std::cos(static_cast<double>(step) * k));
+        offsetSin[k] = radius * static_cast<float>(std::sin(static_cast<double>(step) * k));
+    }
+    const double blockCos { std::cos(static_cast<double>(step) * BLOCK) };
+    const double blockSin { std::sin(static_cast<double>(step) * BLOCK) };
+
+    double startCos {};
+    double startSin {};
+    for (std::size_t first = 0; first < count; first += BLOCK) {
+        if (first % (BLOCK * RESEED_BLOCKS) == 0) {
+            const double angle { startAngle + static_cast<double>(step) * static_cast<double>(first) };
+            startCos = std::cos(angle);
+            startSin = std::sin(angle);
+        }
+        const auto c { static_cast<float>(startCos) };
+        const auto s { static_cast<float>(startSin) };
+        float x[BLOCK];
+        float y[BLOCK];
+        for (std::size_t k = 0; k < BLOCK; ++k) {
+            x[k] = center.x + c * offsetCos[k] - s * offsetSin[k];
+            y[k] = center.y + s * offsetCos[k] + c * offsetSin[k];
+        }
+        const std::size_t blockCount { std::min(BLOCK, count - first) };
+        GLfloat* out { positions + first * stride };
+        for (std::size_t k = 0; k < blockCount; ++k) {
+            out[k * stride] = x[k];
+            out[k * stride + 1] = y[k];
+        }
+
+        const double nextCos { startCos * blockCos - startSin * blockSin };
+        startSin = startSin * blockCos + startCos * blockSin;
+        startCos = nextCos;
+    }
+}
+
+Geometry::Counts Geometry::polygonCounts(const int sides, const Topology topology) {
+    if (sides < 3 || topology == Topology::Strip) {
+        return {};
+    }
+    const auto rimCount { static_cast<std::size_t>(sides) };
+    return { rimCount + 1, fanIndexCount(rimCount, topology) };
+}
+
+Geometry::Counts Geometry::polygon(const Target& target, const int sides, const glm::vec2 center, const float radius,
+    const Topology topology, const float startAngle) {
+    if (!checkCount(sides, 3, "SIDES") || !checkTopology(topology, Topology::Fan, "polygon")) {
+        return {};
+    }
+    target.positions[0] = center.x;
+    target.positions[1] = center.y;
+    arc(target.positions + target.stride, target.stride, static_cast<std::size_t>(sides), center, radius, startAngle,
+        static_cast<float>(2.0 * M_PI / sides));
+    if (target.indices) {
+        writeFanIndices(target.indices, target.baseVertex, static_cast<GLuint>(sides), topology);
+    }
+    return polygonCounts(sides, topology);
+}
+
+int Geometry::circleSides(const float radius, const float maxError) {
+    // An edge spanning angle a strays radius * (1 - cos(a / 2)) from the circle.
+    if (radius <= maxError || maxError <= 0.0f) {
+        return 3;
+    }
+    const double angle { 2.0 * std::acos(1.0 - static_cast<double>(maxError) / radius) };
+    return std::max(3, static_cast<int>(std::ceil(2.0 * M_PI / angle)));
+}
+
+Geometry::Counts Geometry::ringCounts(const int segments, const Topology topology) {
+    if (segments < 3 || topology == Topology::Fan) {
+        return {};
+    }
+    const auto count { static_cast<std::size_t>(segments) };
+    return { 2 * count, topology == Topology::Strip ? 2 * count + 2 : 6 * count };
+}
+
+Geometry::Counts Geometry::ring(const Target& target, const int segments, const glm::vec2 center,
+    const float innerRadius, const float outerRadius, const Topology topology) {
+    if (!checkCount(segments, 3, "SEGMENTS") || !checkTopology(topology, Topology::Strip, "ring")) {
+        return {};
+    }
+    const auto count { static_cast<std::size_t>(segments) };
+    const auto step { static_cast<float>(2.0 * M_PI / segments) };
+    arc(target.positions, 2 * target.stride, count, center, outerRadius, 0.0f, step);
+    arc(target.positions + target.stride, 2 * target.stride, count, center, innerRadius, 0.0f, step);
+
+    if (GLuint* indices { target.indices }) {
+        const GLuint base { target.baseVertex };
+        const auto vertexCount { static_cast<GLuint>(2 * count) };
+        if (topology == Topology::Strip) {
+            for (GLuint i = 0; i < vertexCount; ++i) {
+                *indices++ = base + i;
+            }
+            indices[0] = base;
+            indices[1] = base + 1;
+        } else {
+            for (GLuint i = 0; i < vertexCount; i += 2) {
+                const GLuint next { i + 2 == vertexCount ? 0 : i + 2 };
+                indices[0] = base + i;
+                indices[1] = base + i + 1;
+                indices[2] = base + next;
+                indices[3] = base + next;
+                indices[4] = base + i + 1;
+                indices[5] = base + next + 1;
+                indices += 6;
+            }
+        }
+    }
+    return ringCounts(segments, topology);
+}
+
+Geometry::Counts Geometry::roundedRectCounts(const int cornerSegments, const Topology topology) {
+    if (cornerSegments < 1 || topology == Topology::Strip) {
+        return {};
+    }
+    const auto rimCount { 4 * static_cast<std::size_t>(cornerSegments + 1) };
+    return { rimCount + 1, fanIndexCount(rimCount, topology) };
+}
+
+Geometry::Counts Geometry::roundedRect(const Target& target, const glm::vec2 center, const glm::vec2 size,
+    const float cornerRadius, const int cornerSegments, const Topology topology) {
+    if (!checkCount(cornerSegments, 1, "CORNER_SEGMENTS") || !checkTopology(topology, Topology::Fan, "rounded rect")) {
+        return {};
+    }
+    const glm::vec2 half { size.x * 0.5f, size.y * 0.5f };
+    const float radius { std::clamp(cornerRadius, 0.0f, std::min(half.x, half.y)) };
+    const glm::vec2 inner { half.x - radius, half.y - radius };
+    // Counterclockwise from the top right corner, each one a quarter turn.
+    const glm::vec2 cornerCenters[4] {
+        { center.x + inner.x, center.y + inner.y },
+        { center.x - inner.x, center.y + inner.y },
+        { center.x - inner.x, center.y - inner.y },
+        { center.x + inner.x, center.y - inner.y },
+    };
+
+    target.positions[0] = center.x;
+    target.positions[1] = center.y;
+    const auto cornerPoints { static_cast<std::size_t>(cornerSegments + 1) };
+    const auto step { static_cast<float>(M_PI / 2.0 / cornerSegments) };
+    for (std::size_t corner = 0; corner < 4; ++corner) {
+        arc(target.positions + (1 + corner * cornerPoints) * target.stride, target.stride, cornerPoints,
+            cornerCenters[corner], radius, static_cast<float>(M_PI / 2.0 * static_cast<double>(corner)), step);
+    }
+    if (target.indices) {
+        writeFanIndices(target.indices, target.baseVertex, static_cast<GLuint>(4 * cornerPoints), topology);
+    }
+    return roundedRectCounts(cornerSegments, topology);
+}
+
+Geometry::Batch::Batch(const Topology topology, const std::size_t stride) : m_topology(topology), m_stride(stride) {}
+
+Geometry::Target Geometry::Batch::add(const Counts counts) {
+    if (counts.vertices == 0) {
+        return {};
+    }
+    if (m_topology != Topology::Triangles && !m_indices.empty()) {
+        m_indices.push_back(EBO::RESTART_INDEX);
+    }
+    const std::size_t firstVertex { m_positions.size() / m_stride };
+    const std::size_t firstIndex { m_indices.size() };
+    m_positions.resize(m_positions.size() + counts.vertices * m_stride);
+    m_indices.resize(m_indices.size() + counts.indices);
+    return { m_positions.data() + firstVertex * m_stride, m_stride, m_indices.data() + firstIndex,
+             static_cast<GLuint>(firstVertex) };
+}
+
+void Geometry::Batch::clear() {
+    m_positions.clear();
+    m_indices.clear();
+}
+
+GLenum Geometry::Batch::getPrimitiveMode() const {
+    switch (m_topology) {
+        case Topology::Fan:
+            return GL_TRIANGLE_FAN;
+        case Topology::Strip:
+            return GL_TRIANGLE_STRIP;
+        default:
+            return GL_TRIANGLES;
+    }
+}
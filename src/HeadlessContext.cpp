@@ -0,0 +1,206 @@
+#include "HeadlessContext.hpp"
+#include <iostream>
+#include <cstring>
+
+#ifdef COREGL_HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace {
+    bool hasExtension(const char* extensions, const char* name) {
+        if (!extensions) {
+            return false;
+        }
+        const std::size_t length { std::strlen(name) };
+        for (const char* found = std::strstr(extensions, name); found; found = std::strstr(found + length, name)) {
+            const bool startsWord { found == extensions || found[-1] == ' ' };
+            const bool endsWord { found[length] == ' ' || found[length] == '\0' };
+            if (startsWord && endsWord) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    EGLDisplay openDisplay() {
+        const char* clientExtensions { eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS) };
+        const auto getPlatformDisplay { reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT")) };
+
+        if (getPlatformDisplay) {
+            // Mesa's surfaceless platform: no window system at all, llvmpipe when there is no GPU.
+            if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+                if (EGLDisplay display { getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr) };
+                    display != EGL_NO_DISPLAY) {
+                    return display;
+                }
+            }
+
+            // Vendor drivers (NVIDIA) expose GPUs directly as EGL devices.
+            const auto queryDevices { reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT")) };
+            if (queryDevices && hasExtension(clientExtensions, "EGL_EXT_platform_device")) {
+                EGLDeviceEXT device {};
+                EGLint deviceCount {};
+                if (queryDevices(1, &device, &deviceCount) && deviceCount > 0) {
+                    if (EGLDisplay display { getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, nullptr) };
+                        display != EGL_NO_DISPLAY) {
+                        return display;
+                    }
+                }
+            }
+        }
+
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+}
+#endif
+
+HeadlessContext::~HeadlessContext() {
+    destroy();
+}
+
+bool HeadlessContext::isAvailable() {
+#ifdef COREGL_HAS_EGL
+    return true;
+#else
+    return false;
+#endif
+}
+
+void* HeadlessContext::getProcAddress(const char* name) {
+#ifdef COREGL_HAS_EGL
+    return reinterpret_cast<void*>(eglGetProcAddress(name));
+#else
+    (void)name;
+    return nullptr;
+#endif
+}
+
+bool HeadlessContext::create(const int width, const int height, const int versionMajor, const int versionMinor) {
+    m_width = width;
+    m_height = height;
+
+#ifdef COREGL_HAS_EGL
+    EGLDisplay display { openDisplay() };
+    EGLint eglMajor {}, eglMinor {};
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &eglMajor, &eglMinor)) {
+        std::cout << "Failed to initialize an EGL display" << std::endl;
+        return false;
+    }
+    m_display = display;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cout << "EGL implementation has no desktop OpenGL support" << std::endl;
+        return false;
+    }
+
+    const char* displayExtensions { eglQueryString(display, EGL_EXTENSIONS) };
+    const bool surfaceless { hasExtension(displayExtensions, "EGL_KHR_surfaceless_context") };
+
+    // Surfaceless contexts need no config; pbuffer contexts need one that can back a pbuffer.
+    EGLConfig config { EGL_NO_CONFIG_KHR };
+    const bool configless { surfaceless && hasExtension(displayExtensions, "EGL_KHR_no_config_context") };
+    if (!configless) {
+        const EGLint configAttributes[] {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_NONE
+        };
+        EGLint configCount {};
+        if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+            std::cout << "No EGL config supports off-screen OpenGL rendering" << std::endl;
+            return false;
+        }
+    }
+
+    const EGLint contextAttributes[] {
+        EGL_CONTEXT_MAJOR_VERSION, versionMajor,
+        EGL_CONTEXT_MINOR_VERSION, versionMinor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    m_context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+    if (m_context == EGL_NO_CONTEXT) {
+        std::cout << "Failed to create an EGL OpenGL " << versionMajor << "." << versionMinor << " core context" << std::endl;
+        m_context = nullptr;
+        return false;
+    }
+
+    if (!surfaceless) {
+        // Only needed to make the context current; all drawing goes to the FBO.
+        const EGLint pbufferAttributes[] { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        m_surface = eglCreatePbufferSurface(display, config, pbufferAttributes);
+        if (m_surface == EGL_NO_SURFACE) {
+            std::cout << "Failed to create an EGL pbuffer" << std::endl;
+            m_surface = nullptr;
+            return false;
+        }
+    }
+
+    const EGLSurface surface { m_surface ? m_surface : EGL_NO_SURFACE };
+    if (!eglMakeCurrent(display, surface, surface, m_context)) {
+        std::cout << "Failed to make the EGL context current" << std::endl;
+        return false;
+    }
+
+    std::cout << "Headless EGL " << eglMajor << "." << eglMinor << " context created ("
+              << (surfaceless ? "surfaceless" : "pbuffer") << ")" << std::endl;
+    return true;
+#else
+    (void)versionMajor;
+    (void)versionMinor;
+    std::cout << "Headless mode unavailable: CoreGL was built without EGL" << std::endl;
+    return false;
+#endif
+}
+
+bool HeadlessContext::createFramebuffer() {
+    glGenRenderbuffers(1, &m_colorRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_width, m_height);
+
+    glGenRenderbuffers(1, &m_depthRBO);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_width, m_height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorRBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthRBO);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cout << "Headless framebuffer is incomplete" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void HeadlessContext::destroy() {
+#ifdef COREGL_HAS_EGL
+    if (m_context) {
+        if (m_FBO) {
+            glDeleteFramebuffers(1, &m_FBO);
+            glDeleteRenderbuffers(1, &m_colorRBO);
+            glDeleteRenderbuffers(1, &m_depthRBO);
+        }
+        eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(m_display, m_context);
+    }
+    if (m_surface) {
+        eglDestroySurface(m_display, m_surface);
+    }
+    if (m_display) {
+        eglTerminate(m_display);
+    }
+#endif
+    m_FBO = m_colorRBO = m_depthRBO = 0;
+    m_display = m_context = m_surface = nullptr;
+}
+
+void HeadlessContext::readPixels(std::vector<GLubyte>& pixels) const {
+    pixels.resize(static_cast<std::size_t>(m_width) * m_height * 4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_FBO);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+}
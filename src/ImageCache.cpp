@@ -0,0 +1,189 @@
+#include "ImageCache.hpp"
+#include "MappedFile.hpp"
+#include "Hash.hpp"
+#include "stb_image.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr std::uint32_t CACHE_MAGIC { 0x49474C43 }; // "CGLI"
+    // Bump when MipChain's filtering changes, so old entries stop matching.
+    constexpr std::uint32_t CACHE_VERSION { 1 };
+    constexpr std::size_t DATA_ALIGNMENT { 64 };
+
+    struct EntryHeader {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t key;
+        std::uint32_t numChannels;
+        std::uint32_t levelCount;
+        std::uint64_t dataOffset;
+        std::uint64_t dataSize;
+    };
+
+    struct EntryLevel {
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint64_t offset; // From dataOffset.
+        std::uint64_t size;
+    };
+
+    std::filesystem::path defaultDirectory() {
+        const char* directory { std::getenv("COREGL_IMAGE_CACHE_DIR") };
+        return directory ? std::filesystem::path(directory) : std::filesystem::path("image_cache");
+    }
+
+    std::filesystem::path& cacheDirectory() {
+        static std::filesystem::path directory { defaultDirectory() };
+        return directory;
+    }
+
+    std::vector<GLubyte> readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return {};
+        }
+        std::vector<GLubyte> bytes(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return file ? bytes : std::vector<GLubyte> {};
+    }
+}
+
+void ImageCache::setDirectory(const std::filesystem::path& directory) {
+    cacheDirectory() = directory;
+}
+
+const std::filesystem::path& ImageCache::getDirectory() {
+    return cacheDirectory();
+}
+
+bool ImageCache::isEnabled() {
+    return !cacheDirectory().empty();
+}
+
+std::uint64_t ImageCache::makeKey(const void* fileData, const std::size_t fileSize, const int desiredChannels) {
+    const std::uint64_t parameters[] { CACHE_VERSION, fileSize, static_cast<std::uint64_t>(desiredChannels) };
+    return fnv1a64(fileData, fileSize, fnv1a64(parameters, sizeof(parameters)));
+}
+
+std::filesystem::path ImageCache::entryPath(const std::uint64_t key) {
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx.img", static_cast<unsigned long long>(key));
+    return cacheDirectory() / name;
+}
+
+MipChain ImageCache::load(const std::uint64_t key) {
+    if (!isEnabled()) {
+        return {};
+    }
+    auto file { std::make_shared<const MappedFile>(entryPath(key)) };
+    if (file->getSize() < sizeof(EntryHeader)) {
+        return {};
+    }
+
+    // Every field is checked against the file size, so a truncated or foreign file is just a miss.
+    EntryHeader header {};
+    std::memcpy(&header, file->getData(), sizeof(header));
+    const std::uint64_t tableEnd { sizeof(EntryHeader) + static_cast<std::uint64_t>(header.levelCount) * sizeof(EntryLevel) };
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.key != key
+        || header.numChannels < 1 || header.numChannels > 4 || header.levelCount == 0 || header.levelCount > 32
+        || header.dataOffset < tableEnd || header.dataOffset > file->getSize()
+        || header.dataSize > file->getSize() - header.dataOffset) {
+        return {};
+    }
+
+    std::vector<MipChain::Level> levels(header.levelCount);
+    for (std::uint32_t i = 0; i < header.levelCount; ++i) {
+        EntryLevel level {};
+        std::memcpy(&level, file->getData() + sizeof(EntryHeader) + i * sizeof(EntryLevel), sizeof(level));
+        if (level.width == 0 || level.height == 0 || level.offset > header.dataSize
+            || level.size > header.dataSize - level.offset
+            || level.size != static_cast<std::uint64_t>(level.width) * level.height * header.numChannels) {
+            return {};
+        }
+        levels[i] = { static_cast<GLsizei>(level.width), static_cast<GLsizei>(level.height),
+            static_cast<std::size_t>(level.offset), static_cast<std::size_t>(level.size) };
+    }
+
+    const GLubyte* data { file->getData() + header.dataOffset };
+    return MipChain::fromMapping(std::move(file), data, static_cast<std::size_t>(header.dataSize), std::move(levels),
+        static_cast<int>(header.numChannels));
+}
+
+void ImageCache::store(const std::uint64_t key, const MipChain& mips) {
+    if (!isEnabled() || mips.empty()) {
+        return;
+    }
+
+    const std::size_t tableEnd { sizeof(EntryHeader) + mips.getLevels().size() * sizeof(EntryLevel) };
+    const std::size_t dataOffset { (tableEnd + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT };
+    std::vector<char> head(dataOffset, 0);
+    const EntryHeader header { CACHE_MAGIC, CACHE_VERSION, key, static_cast<std::uint32_t>(mips.getNumChannels()),
+        static_cast<std::uint32_t>(mips.getLevels().size()), dataOffset, mips.getSize() };
+    std::memcpy(head.data(), &header, sizeof(header));
+    for (std::size_t i = 0; i < mips.getLevels().size(); ++i) {
+        const MipChain::Level& level { mips.getLevels()[i] };
+        const EntryLevel entry { static_cast<std::uint32_t>(level.width), static_cast<std::uint32_t>(level.height),
+            level.offset, level.size };
+        std::memcpy(head.data() + sizeof(EntryHeader) + i * sizeof(EntryLevel), &entry, sizeof(entry));
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory(), error);
+    // Written beside the entry and renamed over it, so a concurrent reader never sees half a file. Loader
+    // threads may store the same image at once, hence the per-thread name.
+    const std::filesystem::path path { entryPath(key) };
+    std::filesystem::path temporary { path };
+    temporary += "." + std::to_string(std::hash<std::thread::id> {}(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(head.data(), static_cast<std::streamsize>(head.size()));
+        file.write(reinterpret_cast<const char*>(mips.getData()), static_cast<std::streamsize>(mips.getSize()));
+        if (!file) {
+            std::cout << "ERROR::IMAGE_CACHE::WRITE_FAILED: " << temporary.string() << std::endl;
+            file.close();
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cout << "ERROR::IMAGE_CACHE::WRITE_FAILED: " << path.string() << std::endl;
+        std::filesystem::remove(temporary, error);
+    }
+}
+
+MipChain ImageCache::decode(const std::string& path, const int desiredChannels) {
+    // The encoded file is read either way; hashing it costs far less than decoding it.
+    const std::vector<GLubyte> file { readFile(path) };
+    if (file.empty()) {
+        return {};
+    }
+    const std::uint64_t key { makeKey(file.data(), file.size(), desiredChannels) };
+    if (MipChain cached { load(key) }; !cached.empty()) {
+        return cached;
+    }
+
+    stbi_set_flip_vertically_on_load_thread(true); // Flip texture vertically to match OpenGL's coordinate system
+    int width, height, numChannels;
+    GLubyte* pixels { stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height,
+        &numChannels, desiredChannels) };
+    if (!pixels) {
+        return {};
+    }
+    if (desiredChannels != 0) {
+        numChannels = desiredChannels;
+    }
+    // Three and four channel images are colour; the rest are treated as data.
+    MipChain mips { MipChain::build(pixels, width, height, numChannels, numChannels >= 3) };
+    stbi_image_free(pixels);
+    store(key, mips);
+    return mips;
+}
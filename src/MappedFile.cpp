@@ -0,0 +1,98 @@
+#include "MappedFile.hpp"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    const HANDLE file { CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER size {};
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping) {
+            m_data = static_cast<const std::uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            m_size = m_data ? static_cast<std::size_t>(size.QuadPart) : 0;
+        }
+    }
+    CloseHandle(file); // The mapping keeps the file open.
+    if (!m_data) {
+        close();
+    }
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_size = 0;
+}
+#else
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    const int file { ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+    if (file < 0) {
+        return;
+    }
+    struct stat status {};
+    if (fstat(file, &status) == 0 && status.st_size > 0) {
+        void* data { mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0) };
+        if (data != MAP_FAILED) {
+            m_data = static_cast<const std::uint8_t*>(data);
+            m_size = static_cast<std::size_t>(status.st_size);
+        }
+    }
+    ::close(file); // The mapping keeps the file open.
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+#ifdef _WIN32
+    , m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+}
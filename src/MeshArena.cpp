@@ -0,0 +1,42 @@
+#include "MeshArena.hpp"
+#include "MeshOptimizer.hpp"
+#include <iostream>
+
+MeshArena::MeshArena(const GLsizei stride) : m_stride(stride) {}
+
+MeshArena::Mesh MeshArena::add(const void* vertices, const GLsizei vertexCount, const GLuint* indices,
+    const GLsizei indexCount) {
+    if (isBuilt()) {
+        std::cout << "ERROR::MESH_ARENA::ALREADY_BUILT" << std::endl;
+        return {};
+    }
+    const Mesh mesh { static_cast<GLuint>(m_indices.size()), static_cast<GLuint>(indexCount),
+                      static_cast<GLint>(m_vertices.size() / static_cast<std::size_t>(m_stride)) };
+    const auto* bytes { static_cast<const GLubyte*>(vertices) };
+    m_vertices.insert(m_vertices.end(), bytes, bytes + static_cast<std::size_t>(vertexCount) * m_stride);
+    m_indices.insert(m_indices.end(), indices, indices + indexCount);
+    return mesh;
+}
+
+MeshArena::Mesh MeshArena::addOptimized(std::vector<GLfloat> vertices, std::vector<GLuint> indices,
+    const std::size_t positionComponents) {
+    const std::size_t floatsPerVertex { static_cast<std::size_t>(m_stride) / sizeof(GLfloat) };
+    const MeshOptimizer::Report report { MeshOptimizer::optimize(vertices, floatsPerVertex, indices,
+        positionComponents) };
+    std::cout << "Optimized mesh of " << indices.size() / 3 << " triangles: " << report << std::endl;
+    return add(vertices.data(), static_cast<GLsizei>(vertices.size() / floatsPerVertex), indices.data(),
+        static_cast<GLsizei>(indices.size()));
+}
+
+void MeshArena::build() {
+    if (isBuilt()) {
+        std::cout << "ERROR::MESH_ARENA::ALREADY_BUILT" << std::endl;
+        return;
+    }
+    m_VBO = std::make_unique<VBO>(m_vertices.data(), static_cast<GLsizeiptr>(m_vertices.size()));
+    m_EBO = std::make_unique<EBO>(m_indices.data(), static_cast<GLsizeiptr>(m_indices.size() * sizeof(GLuint)));
+    m_VAO.setElementBuffer(*m_EBO);
+    // The GPU has its copy.
+    m_vertices = {};
+    m_indices = {};
+}
@@ -0,0 +1,382 @@
+#include "MeshOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <numeric>
+
+namespace {
+    // Cache line size and line count of the vertex fetch model (4 KB).
+    constexpr std::size_t LINE_SIZE { 64 };
+    constexpr std::size_t FETCH_CACHE_LINES { 64 };
+
+    // FIFO post-transform cache: a vertex is resident while fewer than cacheSize misses happened since it was
+    // loaded. reset() empties it by moving the clock past every entry.
+    class CacheModel {
+        std::vector<std::size_t> m_loadedAt;
+        std::size_t m_cacheSize;
+        std::size_t m_clock;
+
+    public:
+        CacheModel(const std::size_t vertexCount, const std::size_t cacheSize)
+            : m_loadedAt(vertexCount, 0), m_cacheSize(cacheSize), m_clock(cacheSize + 1) {}
+
+        // True on a miss, which loads the vertex.
+        bool access(const GLuint vertex) {
+            if (m_clock - m_loadedAt[vertex] <= m_cacheSize) {
+                return false;
+            }
+            m_loadedAt[vertex] = m_clock++;
+            return true;
+        }
+
+        // How long ago the vertex was loaded, in misses; more than the cache size means evicted.
+        [[nodiscard]] std::size_t age(const GLuint vertex) const {
+            return m_clock - m_loadedAt[vertex];
+        }
+
+        void reset() {
+            m_clock += m_cacheSize + 1;
+        }
+    };
+
+    // Triangles using each vertex, as one flat list with an offset per vertex.
+    struct Adjacency {
+        std::vector<GLuint> counts;
+        std::vector<std::size_t> offsets;
+        std::vector<GLuint> triangles;
+
+        Adjacency(const GLuint* indices, const std::size_t indexCount, const std::size_t vertexCount)
+            : counts(vertexCount, 0), offsets(vertexCount + 1, 0), triangles(indexCount) {
+            for (std::size_t i = 0; i < indexCount; ++i) {
+                ++counts[indices[i]];
+            }
+            for (std::size_t v = 0; v < vertexCount; ++v) {
+                offsets[v + 1] = offsets[v] + counts[v];
+            }
+            std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < indexCount; ++i) {
+                triangles[fill[indices[i]]++] = static_cast<GLuint>(i / 3);
+            }
+        }
+    };
+
+    // Copy of indices when the caller asked to write over them.
+    const GLuint* sourceFor(const GLuint* destination, const GLuint* indices, const std::size_t indexCount,
+        std::vector<GLuint>& copy) {
+        if (destination != indices) {
+            return indices;
+        }
+        copy.assign(indices, indices + indexCount);
+        return copy.data();
+    }
+
+    std::size_t countReferenced(const GLuint* indices, const std::size_t indexCount, const std::size_t vertexCount) {
+        std::vector<bool> used(vertexCount, false);
+        std::size_t referenced {};
+        for (std::size_t i = 0; i < indexCount; ++i) {
+            if (!used[indices[i]]) {
+                used[indices[i]] = true;
+                ++referenced;
+            }
+        }
+        return referenced;
+    }
+
+    // Next vertex to fan around: among the candidates that stay in cache while their remaining triangles are
+    // emitted, the one loaded longest ago (priority above 0); otherwise the most recent dead end with triangles left, otherwise the next such vertex
+    // in index order. -1 once every triangle is out.
+    long long nextFanningVertex(const std::vector<GLuint>& candidates, const std::vector<GLuint>& live,
+        const CacheModel& cache, const std::size_t cacheSize, std::vector<GLuint>& deadEnds, std::size_t& cursor) {
+        long long best { -1 };
+        std::size_t bestPriority {};
+        for (const GLuint vertex : candidates) {
+            if (live[vertex] == 0 || cache.age(vertex) + 2 * live[vertex] > cacheSize) {
+                continue;
+            }
+            const std::size_t priority { cache.age(vertex) };
+            if (priority > bestPriority) {
+                best = vertex;
+                bestPriority = priority;
+            }
+        }
+        if (best >= 0) {
+            return best;
+        }
+        while (!deadEnds.empty()) {
+            const GLuint vertex { deadEnds.back() };
+            deadEnds.pop_back();
+            if (live[vertex] > 0) {
+                return vertex;
+            }
+        }
+        for (; cursor < live.size(); ++cursor) {
+            if (live[cursor] > 0) {
+                return static_cast<long long>(cursor++);
+            }
+        }
+        return -1;
+    }
+
+    void accumulate(float* sum, const float* value) {
+        sum[0] += value[0];
+        sum[1] += value[1];
+        sum[2] += value[2];
+    }
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::analyzeVertexCache(const GLuint* indices, const std::size_t indexCount,
+    const std::size_t vertexCount, const std::size_t cacheSize) {
+    CacheStats stats {};
+    if (indexCount < 3) {
+        return stats;
+    }
+    CacheModel cache(vertexCount, cacheSize);
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        stats.transforms += cache.access(indices[i]);
+    }
+    stats.acmr = static_cast<float>(stats.transforms) / static_cast<float>(indexCount / 3);
+    stats.atvr = static_cast<float>(stats.transforms) /
+        static_cast<float>(countReferenced(indices, indexCount, vertexCount));
+    return stats;
+}
+
+MeshOptimizer::FetchStats MeshOptimizer::analyzeVertexFetch(const GLuint* indices, const std::size_t indexCount,
+    const std::size_t vertexCount, const std::size_t vertexSize, const std::size_t cacheSize) {
+    FetchStats stats {};
+    if (indexCount == 0 || vertexSize == 0) {
+        return stats;
+    }
+    // Only transformed vertices are fetched; each fetch pulls every line the vertex touches unless the line is
+    // still among the last FETCH_CACHE_LINES loaded.
+    CacheModel cache(vertexCount, cacheSize);
+    CacheModel lines((vertexCount * vertexSize + LINE_SIZE - 1) / LINE_SIZE, FETCH_CACHE_LINES);
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        const GLuint vertex { indices[i] };
+        if (!cache.access(vertex)) {
+            continue;
+        }
+        const std::size_t first { vertex * vertexSize / LINE_SIZE };
+        const std::size_t last { (vertex * vertexSize + vertexSize - 1) / LINE_SIZE };
+        for (std::size_t line = first; line <= last; ++line) {
+            stats.bytesFetched += lines.access(static_cast<GLuint>(line)) ? LINE_SIZE : 0;
+        }
+    }
+    stats.overfetch = static_cast<float>(stats.bytesFetched) /
+        static_cast<float>(countReferenced(indices, indexCount, vertexCount) * vertexSize);
+    return stats;
+}
+
+void MeshOptimizer::optimizeVertexCache(GLuint* destination, const GLuint* indices, const std::size_t indexCount,
+    const std::size_t vertexCount, const std::size_t cacheSize) {
+    std::vector<GLuint> copy;
+    const GLuint* source { sourceFor(destination, indices, indexCount, copy) };
+    const std::size_t triangleCount { indexCount / 3 };
+    const Adjacency adjacency(source, triangleCount * 3, vertexCount);
+
+    std::vector<GLuint> live { adjacency.counts };
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<GLuint> deadEnds;
+    std::vector<GLuint> candidates;
+    CacheModel cache(vertexCount, cacheSize);
+    std::size_t cursor {};
+    std::size_t written {};
+
+    long long fanning { nextFanningVertex(candidates, live, cache, cacheSize, deadEnds, cursor) };
+    while (fanning >= 0) {
+        const auto vertex { static_cast<GLuint>(fanning) };
+        candidates.clear();
+        for (std::size_t k = adjacency.offsets[vertex]; k < adjacency.offsets[vertex + 1]; ++k) {
+            const GLuint triangle { adjacency.triangles[k] };
+            if (emitted[triangle]) {
+                continue;
+            }
+            emitted[triangle] = true;
+            for (std::size_t corner = 0; corner < 3; ++corner) {
+                const GLuint index { source[triangle * 3 + corner] };
+                destination[written++] = index;
+                deadEnds.push_back(index);
+                candidates.push_back(index);
+                --live[index];
+                cache.access(index);
+            }
+        }
+        fanning = nextFanningVertex(candidates, live, cache, cacheSize, deadEnds, cursor);
+    }
+}
+
+void MeshOptimizer::optimizeOverdraw(GLuint* destination, const GLuint* indices, const std::size_t indexCount,
+    const GLfloat* positions, const std::size_t positionStride, const std::size_t vertexCount, const float threshold,
+    const std::size_t cacheSize) {
+    std::vector<GLuint> copy;
+    const GLuint* source { sourceFor(destination, indices, indexCount, copy) };
+    const std::size_t triangleCount { indexCount / 3 };
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Hard boundaries: triangles where the cache ordering started over (all three corners missed).
+    CacheModel cache(vertexCount, cacheSize);
+    std::vector<std::size_t> hard;
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        const std::size_t misses { static_cast<std::size_t>(cache.access(source[t * 3])) +
+            cache.access(source[t * 3 + 1]) + cache.access(source[t * 3 + 2]) };
+        if (t == 0 || misses == 3) {
+            hard.push_back(t);
+        }
+    }
+    hard.push_back(triangleCount);
+
+    // Soft boundaries: within a hard cluster, cut as soon as the part so far is within threshold of the
+    // cluster's own ACMR. Each cut flushes the cache, which is what bounds the cost.
+    std::vector<std::size_t> clusters;
+    for (std::size_t h = 0; h + 1 < hard.size(); ++h) {
+        const std::size_t begin { hard[h] };
+        const std::size_t end { hard[h + 1] };
+        cache.reset();
+        std::size_t clusterMisses {};
+        for (std::size_t i = begin * 3; i < end * 3; ++i) {
+            clusterMisses += cache.access(source[i]);
+        }
+        const float limit { threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin) };
+
+        cache.reset();
+        clusters.push_back(begin);
+        std::size_t misses {};
+        std::size_t start { begin };
+        for (std::size_t t = begin; t < end; ++t) {
+            misses += static_cast<std::size_t>(cache.access(source[t * 3])) + cache.access(source[t * 3 + 1]) +
+                cache.access(source[t * 3 + 2]);
+            if (t + 1 < end && static_cast<float>(misses) <= limit * static_cast<float>(t + 1 - start)) {
+                clusters.push_back(t + 1);
+                cache.reset();
+                misses = 0;
+                start = t + 1;
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+
+    float meshCenter[3] {};
+    std::size_t referenced {};
+    std::vector<bool> used(vertexCount, false);
+    for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+        if (!used[source[i]]) {
+            used[source[i]] = true;
+            accumulate(meshCenter, positions + source[i] * positionStride);
+            ++referenced;
+        }
+    }
+    for (float& component : meshCenter) {
+        component /= static_cast<float>(referenced);
+    }
+
+    // Clusters whose area weighted normal points away from the mesh center go first.
+    const std::size_t clusterCount { clusters.size() - 1 };
+    std::vector<float> facing(clusterCount, 0.0f);
+    for (std::size_t c = 0; c < clusterCount; ++c) {
+        float center[3] {};
+        float normal[3] {};
+        float area {};
+        for (std::size_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+            const float* a { positions + source[t * 3] * positionStride };
+            const float* b { positions + source[t * 3 + 1] * positionStride };
+            const float* p { positions + source[t * 3 + 2] * positionStride };
+            const float u[3] { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            const float v[3] { p[0] - a[0], p[1] - a[1], p[2] - a[2] };
+            const float cross[3] { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+            const float twiceArea { std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]) };
+            for (std::size_t k = 0; k < 3; ++k) {
+                center[k] += (a[k] + b[k] + p[k]) / 3.0f * twiceArea;
+            }
+            accumulate(normal, cross);
+            area += twiceArea;
+        }
+        const float length { std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]) };
+        if (area > 0.0f && length > 0.0f) {
+            for (std::size_t k = 0; k < 3; ++k) {
+                facing[c] += (center[k] / area - meshCenter[k]) * normal[k] / length;
+            }
+        }
+    }
+
+    std::vector<std::size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&facing](const std::size_t a, const std::size_t b) {
+        return facing[a] > facing[b];
+    });
+    std::size_t written {};
+    for (const std::size_t c : order) {
+        const std::size_t count { (clusters[c + 1] - clusters[c]) * 3 };
+        std::memcpy(destination + written, source + clusters[c] * 3, count * sizeof(GLuint));
+        written += count;
+    }
+}
+
+std::size_t MeshOptimizer::optimizeVertexFetch(GLuint* remap, const GLuint* indices, const std::size_t indexCount,
+    const std::size_t vertexCount) {
+    std::fill(remap, remap + vertexCount, NO_VERTEX);
+    GLuint next {};
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        if (remap[indices[i]] == NO_VERTEX) {
+            remap[indices[i]] = next++;
+        }
+    }
+    return next;
+}
+
+void MeshOptimizer::remapIndices(GLuint* destination, const GLuint* indices, const std::size_t indexCount,
+    const GLuint* remap) {
+    for (std::size_t i = 0; i < indexCount; ++i) {
+        destination[i] = remap[indices[i]];
+    }
+}
+
+void MeshOptimizer::remapVertices(void* destination, const void* vertices, const std::size_t vertexCount,
+    const std::size_t vertexSize, const GLuint* remap) {
+    auto* out { static_cast<GLubyte*>(destination) };
+    const auto* in { static_cast<const GLubyte*>(vertices) };
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        if (remap[v] != NO_VERTEX) {
+            std::memcpy(out + remap[v] * vertexSize, in + v * vertexSize, vertexSize);
+        }
+    }
+}
+
+MeshOptimizer::Report MeshOptimizer::optimize(std::vector<GLfloat>& vertices, const std::size_t floatsPerVertex,
+    std::vector<GLuint>& indices, const std::size_t positionComponents) {
+    const std::size_t vertexCount { vertices.size() / floatsPerVertex };
+    const std::size_t vertexSize { floatsPerVertex * sizeof(GLfloat) };
+    Report report {};
+    report.cacheBefore = analyzeVertexCache(indices.data(), indices.size(), vertexCount);
+    report.fetchBefore = analyzeVertexFetch(indices.data(), indices.size(), vertexCount, vertexSize);
+
+    optimizeVertexCache(indices.data(), indices.data(), indices.size(), vertexCount);
+    if (positionComponents >= 3) {
+        optimizeOverdraw(indices.data(), indices.data(), indices.size(), vertices.data(), floatsPerVertex,
+            vertexCount);
+    }
+
+    std::vector<GLuint> remap(vertexCount);
+    const std::size_t kept { optimizeVertexFetch(remap.data(), indices.data(), indices.size(), vertexCount) };
+    std::vector<GLfloat> reordered(kept * floatsPerVertex);
+    remapVertices(reordered.data(), vertices.data(), vertexCount, vertexSize, remap.data());
+    remapIndices(indices.data(), indices.data(), indices.size(), remap.data());
+    vertices = std::move(reordered);
+
+    report.cacheAfter = analyzeVertexCache(indices.data(), indices.size(), kept);
+    report.fetchAfter = analyzeVertexFetch(indices.data(), indices.size(), kept, vertexSize);
+    return report;
+}
+
+std::ostream& MeshOptimizer::operator<<(std::ostream& out, const Report& report) {
+    const std::ios_base::fmtflags flags { out.flags() };
+    const std::streamsize precision { out.precision() };
+    out << std::fixed << std::setprecision(2)
+        << "ACMR " << report.cacheBefore.acmr << " -> " << report.cacheAfter.acmr
+        << ", ATVR " << report.cacheBefore.atvr << " -> " << report.cacheAfter.atvr
+        << ", overfetch " << report.fetchBefore.overfetch << " -> " << report.fetchAfter.overfetch;
+    out.flags(flags);
+    out.precision(precision);
+    return out;
+}
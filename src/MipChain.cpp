@@ -0,0 +1,151 @@
+#include "MipChain.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+    constexpr std::size_t ENCODE_TABLE_SIZE { 1 << 14 };
+
+    struct SrgbTables {
+        std::array<float, 256> toLinear {};
+        // Indexed by linear * (ENCODE_TABLE_SIZE - 1); fine enough that the darkest sRGB steps still round right.
+        std::array<GLubyte, ENCODE_TABLE_SIZE> toSrgb {};
+
+        SrgbTables() {
+            for (std::size_t i = 0; i < toLinear.size(); ++i) {
+                const double value { static_cast<double>(i) / 255.0 };
+                toLinear[i] = static_cast<float>(value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+            }
+            for (std::size_t i = 0; i < toSrgb.size(); ++i) {
+                const double value { static_cast<double>(i) / (ENCODE_TABLE_SIZE - 1) };
+                const double encoded { value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055 };
+                toSrgb[i] = static_cast<GLubyte>(std::lround(std::clamp(encoded, 0.0, 1.0) * 255.0));
+            }
+        }
+    };
+
+    const SrgbTables& srgbTables() {
+        static const SrgbTables tables;
+        return tables;
+    }
+
+    // Channels 0..colourChannels-1 are sRGB encoded, the rest (alpha) linear. The channel count is a template
+    // parameter so the per-pixel loops unroll.
+    template <int numChannels>
+    void encode(const float* source, GLubyte* destination, const std::size_t pixelCount, const int colourChannels) {
+        const SrgbTables& tables { srgbTables() };
+        for (std::size_t i = 0; i < pixelCount; ++i) {
+            for (int c = 0; c < numChannels; ++c) {
+                const float value { std::clamp(source[i * numChannels + c], 0.0f, 1.0f) };
+                destination[i * numChannels + c] = c < colourChannels
+                    ? tables.toSrgb[static_cast<std::size_t>(value * (ENCODE_TABLE_SIZE - 1) + 0.5f)]
+                    : static_cast<GLubyte>(value * 255.0f + 0.5f);
+            }
+        }
+    }
+
+    // Averages 2x2 blocks of the level above. Level 0 is read straight from the 8-bit image, decoding on
+    // the fly, so no full resolution float copy is ever made.
+    template <int numChannels, typename Source, typename Decode>
+    void halve(const Source* source, const GLsizei width, const GLsizei height, float* destination,
+        const GLsizei nextWidth, const GLsizei nextHeight, Decode decodeValue) {
+        for (GLsizei y = 0; y < nextHeight; ++y) {
+            const Source* row0 { source + static_cast<std::size_t>(std::min(2 * y, height - 1)) * width * numChannels };
+            const Source* row1 { source + static_cast<std::size_t>(std::min(2 * y + 1, height - 1)) * width * numChannels };
+            float* out { destination + static_cast<std::size_t>(y) * nextWidth * numChannels };
+            for (GLsizei x = 0; x < nextWidth; ++x) {
+                const std::size_t left { static_cast<std::size_t>(std::min(2 * x, width - 1)) * numChannels };
+                const std::size_t right { static_cast<std::size_t>(std::min(2 * x + 1, width - 1)) * numChannels };
+                for (int c = 0; c < numChannels; ++c) {
+                    out[x * numChannels + c] = 0.25f * (decodeValue(row0[left + c], c) + decodeValue(row0[right + c], c)
+                        + decodeValue(row1[left + c], c) + decodeValue(row1[right + c], c));
+                }
+            }
+        }
+    }
+
+    template <int numChannels>
+    void filterLevels(const GLubyte* pixels, std::vector<MipChain::Level>& levels, GLubyte* chain,
+        const int colourChannels) {
+        if (levels.size() < 2) {
+            return;
+        }
+        const SrgbTables& tables { srgbTables() };
+        const auto fromBytes { [&tables, colourChannels](const GLubyte value, const int channel) {
+            return channel < colourChannels ? tables.toLinear[value] : value / 255.0f;
+        } };
+        const auto fromFloats { [](const float value, int) {
+            return value;
+        } };
+
+        // Levels below 1 are filtered from the float copy of the level above, so rounding does not pile up
+        // down the chain.
+        std::vector<float> current(levels[1].size);
+        std::vector<float> next;
+        halve<numChannels>(pixels, levels[0].width, levels[0].height, current.data(), levels[1].width,
+            levels[1].height, fromBytes);
+        encode<numChannels>(current.data(), chain + levels[1].offset,
+            static_cast<std::size_t>(levels[1].width) * levels[1].height, colourChannels);
+
+        for (std::size_t i = 2; i < levels.size(); ++i) {
+            const MipChain::Level& above { levels[i - 1] };
+            const MipChain::Level& level { levels[i] };
+            next.resize(level.size);
+            halve<numChannels>(current.data(), above.width, above.height, next.data(), level.width, level.height,
+                fromFloats);
+            encode<numChannels>(next.data(), chain + level.offset, static_cast<std::size_t>(level.width) * level.height,
+                colourChannels);
+            std::swap(current, next);
+        }
+    }
+}
+
+MipChain MipChain::build(const GLubyte* pixels, const GLsizei width, const GLsizei height, const int numChannels,
+    const bool srgb, const GLsizei maxLevels) {
+    MipChain chain;
+    if (!pixels || width <= 0 || height <= 0 || numChannels < 1 || numChannels > 4) {
+        return chain;
+    }
+    chain.m_numChannels = numChannels;
+
+    std::size_t total {};
+    for (GLsizei w { width }, h { height };; w = std::max(1, w / 2), h = std::max(1, h / 2)) {
+        const std::size_t size { static_cast<std::size_t>(w) * h * numChannels };
+        chain.m_levels.push_back({ w, h, total, size });
+        total += size;
+        if ((w == 1 && h == 1) || static_cast<GLsizei>(chain.m_levels.size()) == maxLevels) {
+            break;
+        }
+    }
+    chain.m_data.resize(total);
+    std::copy_n(pixels, chain.m_levels[0].size, chain.m_data.begin());
+
+    const int colourChannels { srgb ? std::min(numChannels, 3) : 0 };
+    switch (numChannels) {
+        case 1:
+            filterLevels<1>(pixels, chain.m_levels, chain.m_data.data(), colourChannels);
+            break;
+        case 2:
+            filterLevels<2>(pixels, chain.m_levels, chain.m_data.data(), colourChannels);
+            break;
+        case 3:
+            filterLevels<3>(pixels, chain.m_levels, chain.m_data.data(), colourChannels);
+            break;
+        default:
+            filterLevels<4>(pixels, chain.m_levels, chain.m_data.data(), colourChannels);
+            break;
+    }
+    return chain;
+}
+
+MipChain MipChain::fromMapping(std::shared_ptr<const MappedFile> mapping, const GLubyte* data, const std::size_t size,
+    std::vector<Level> levels, const int numChannels) {
+    MipChain chain;
+    chain.m_mapping = std::move(mapping);
+    chain.m_mappedData = data;
+    chain.m_mappedSize = size;
+    chain.m_levels = std::move(levels);
+    chain.m_numChannels = numChannels;
+    return chain;
+}
@@ -0,0 +1,457 @@
+#include "Profiler.hpp"
+#include "Hash.hpp"
+#include "imgui.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+    std::string escapeJson(const char* text) {
+        std::string escaped;
+        for (; *text; ++text) {
+            if (*text == '"' || *text == '\\') {
+                escaped += '\\';
+                escaped += *text;
+            } else if (static_cast<unsigned char>(*text) < 0x20) {
+                // JSON strings can't hold raw control characters.
+                char code[7];
+                std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(*text));
+                escaped += code;
+            } else {
+                escaped += *text;
+            }
+        }
+        return escaped;
+    }
+
+    // Stable per-name color, so a zone keeps its color from frame to frame.
+    ImU32 zoneColor(const char* name) {
+        const std::uint64_t hash { fnv1a64(std::string_view(name)) };
+        return IM_COL32(80 + (hash & 0x7F), 80 + ((hash >> 8) & 0x7F), 80 + ((hash >> 16) & 0x7F), 255);
+    }
+
+    double toMs(const std::int64_t nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1'000'000.0;
+    }
+
+    double toUs(const std::int64_t nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1'000.0;
+    }
+
+    void drawBar(ImDrawList* drawList, const ImVec2& min, const ImVec2& max, const char* name,
+                 const ImU32 color, const double ms) {
+        drawList->AddRectFilled(min, max, color);
+        drawList->AddRect(min, max, IM_COL32(20, 20, 20, 255));
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2(min.x + 3.0f, min.y + 1.0f), IM_COL32(255, 255, 255, 255), name);
+        drawList->PopClipRect();
+        if (ImGui::IsMouseHoveringRect(min, max)) {
+            ImGui::SetTooltip("%s\n%.3f ms", name, ms);
+        }
+    }
+}
+
+Profiler::Profiler() : m_epoch(std::chrono::steady_clock::now()), m_gpuTiming(GLAD_GL_VERSION_3_3) {
+    if (const char* path { std::getenv("COREGL_PROFILE_OUTPUT") }) {
+        m_outputPath = path;
+        startCapture();
+    }
+}
+
+Profiler::~Profiler() {
+    // Frames still in flight are dropped: the context may already be gone at this point.
+    if (!m_outputPath.empty()) {
+        writeChromeTrace(m_outputPath);
+    }
+    for (PendingFrame& pending : m_pending) {
+        if (!pending.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(pending.queries.size()), pending.queries.data());
+        }
+    }
+}
+
+std::int64_t Profiler::now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_epoch).count();
+}
+
+// --- Frame and zone recording ---
+void Profiler::beginFrame() {
+    if (m_inFrame) {
+        endFrame();
+    }
+    resolveAvailable();
+
+    PendingFrame& pending { m_pending[m_current] };
+    if (pending.inFlight) {
+        resolve(pending, false); // Still not done after FRAME_LATENCY frames; waiting would stall.
+    }
+
+    pending.frame = Frame {};
+    pending.frame.index = m_frameIndex;
+    pending.frame.cpuBegin = now();
+    pending.queriesUsed = 0;
+
+    if (m_gpuTiming) {
+        // GL_TIMESTAMP read back now and CPU time taken at the same moment put GPU times on the CPU clock.
+        GLint64 gpuNow {};
+        glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+        pending.gpuToCpuOffset = now() - gpuNow;
+        glQueryCounter(nextQuery(pending), GL_TIMESTAMP);
+    }
+    m_inFrame = true;
+}
+
+void Profiler::endFrame() {
+    if (!m_inFrame) {
+        return;
+    }
+    while (!m_openZones.empty()) {
+        endZone();
+    }
+
+    PendingFrame& pending { m_pending[m_current] };
+    pending.frame.cpuEnd = now();
+    if (m_gpuTiming) {
+        glQueryCounter(nextQuery(pending), GL_TIMESTAMP);
+        pending.inFlight = true;
+    } else {
+        publish(std::move(pending.frame));
+    }
+
+    m_current = (m_current + 1) % FRAME_LATENCY;
+    ++m_frameIndex;
+    m_inFrame = false;
+}
+
+void Profiler::beginZone(const char* name) {
+    if (!m_inFrame) {
+        return;
+    }
+    PendingFrame& pending { m_pending[m_current] };
+    Zone zone { name, static_cast<int>(m_openZones.size()) };
+    if (m_gpuTiming) {
+        // The begin query's index is parked in gpuBegin until resolve() swaps in the timestamp.
+        const GLuint query { nextQuery(pending) };
+        zone.gpuBegin = static_cast<std::int64_t>(pending.queriesUsed - 1);
+        glQueryCounter(query, GL_TIMESTAMP);
+    }
+    zone.cpuBegin = now();
+    m_openZones.push_back(pending.frame.zones.size());
+    pending.frame.zones.push_back(zone);
+}
+
+void Profiler::endZone() {
+    if (!m_inFrame || m_openZones.empty()) {
+        return;
+    }
+    PendingFrame& pending { m_pending[m_current] };
+    Zone& zone { pending.frame.zones[m_openZones.back()] };
+    m_openZones.pop_back();
+    zone.cpuEnd = now();
+    if (m_gpuTiming) {
+        const GLuint query { nextQuery(pending) };
+        zone.gpuEnd = static_cast<std::int64_t>(pending.queriesUsed - 1);
+        glQueryCounter(query, GL_TIMESTAMP);
+    }
+}
+
+GLuint Profiler::nextQuery(PendingFrame& pending) {
+    if (pending.queriesUsed == pending.queries.size()) {
+        const std::size_t grown { std::max<std::size_t>(16, pending.queries.size() * 2) };
+        const std::size_t added { grown - pending.queries.size() };
+        pending.queries.resize(grown);
+        glGenQueries(static_cast<GLsizei>(added), pending.queries.data() + (grown - added));
+    }
+    return pending.queries[pending.queriesUsed++];
+}
+
+// --- Read back ---
+void Profiler::resolveAvailable() {
+    // Oldest first, stopping at the first frame the GPU has not finished, so history stays in order.
+    for (std::size_t age = 0; age < FRAME_LATENCY; ++age) {
+        PendingFrame& pending { m_pending[(m_current + age) % FRAME_LATENCY] };
+        if (!pending.inFlight) {
+            continue;
+        }
+        // Queries complete in submission order, so the frame's last one decides.
+        GLint available {};
+        glGetQueryObjectiv(pending.queries[pending.queriesUsed - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+        resolve(pending, true);
+    }
+}
+
+void Profiler::resolve(PendingFrame& pending, const bool readGpu) {
+    Frame& frame { pending.frame };
+    if (readGpu) {
+        std::vector<GLint64> timestamps(pending.queriesUsed);
+        for (std::size_t i = 0; i < pending.queriesUsed; ++i) {
+            glGetQueryObjecti64v(pending.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+        }
+        const std::int64_t offset { pending.gpuToCpuOffset };
+        frame.gpuBegin = timestamps.front() + offset;
+        frame.gpuEnd = timestamps.back() + offset;
+        for (Zone& zone : frame.zones) {
+            zone.gpuBegin = timestamps[static_cast<std::size_t>(zone.gpuBegin)] + offset;
+            zone.gpuEnd = timestamps[static_cast<std::size_t>(zone.gpuEnd)] + offset;
+        }
+        frame.hasGpuTimes = true;
+    } else {
+        for (Zone& zone : frame.zones) {
+            zone.gpuBegin = 0;
+            zone.gpuEnd = 0;
+        }
+    }
+    pending.inFlight = false;
+    publish(std::move(frame));
+    frame = Frame {};
+}
+
+void Profiler::publish(Frame&& frame) {
+    if (m_capturing && m_capture.size() < MAX_CAPTURED_FRAMES) {
+        m_capture.push_back(frame);
+    }
+    if (m_paused) {
+        return; // Keeps the frame on screen still.
+    }
+    m_history.push_back(std::move(frame));
+    if (m_history.size() > HISTORY_SIZE) {
+        m_history.pop_front();
+    }
+}
+
+// --- Chrome trace export ---
+void Profiler::startCapture() {
+    m_capture.clear();
+    m_capturing = true;
+}
+
+void Profiler::stopCapture() {
+    m_capturing = false;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cout << "ERROR::PROFILER::CANNOT_WRITE_TRACE: " << path << std::endl;
+        return false;
+    }
+
+    // CPU zones on thread 1, GPU zones on thread 2 of the same process; "X" events carry their duration.
+    out << "{\"traceEvents\":[\n"
+        << R"({"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"CPU"}},)" << '\n'
+        << R"({"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"GPU"}})";
+
+    const auto writeEvent = [&out](const char* name, const int tid, const std::int64_t begin, const std::int64_t end) {
+        out << ",\n{\"name\":\"" << escapeJson(name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+            << ",\"ts\":" << toUs(begin) << ",\"dur\":" << toUs(end - begin) << '}';
+    };
+
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    const auto writeFrames = [&](const auto& frames) {
+        for (const Frame& frame : frames) {
+            writeEvent("Frame", 1, frame.cpuBegin, frame.cpuEnd);
+            for (const Zone& zone : frame.zones) {
+                writeEvent(zone.name, 1, zone.cpuBegin, zone.cpuEnd);
+            }
+            if (!frame.hasGpuTimes) {
+                continue;
+            }
+            writeEvent("Frame", 2, frame.gpuBegin, frame.gpuEnd);
+            for (const Zone& zone : frame.zones) {
+                writeEvent(zone.name, 2, zone.gpuBegin, zone.gpuEnd);
+            }
+        }
+    };
+    if (m_capturing || !m_capture.empty()) {
+        writeFrames(m_capture);
+    } else {
+        writeFrames(m_history);
+    }
+    out << "\n]}\n";
+
+    std::cout << "Profiler trace written to " << path << std::endl;
+    return true;
+}
+
+// --- ImGui panel ---
+void Profiler::drawImGui() {
+    if (!ImGui::Begin("Profiler")) {
+        ImGui::End();
+        return;
+    }
+    if (m_history.empty()) {
+        ImGui::TextDisabled("Waiting for the first frames...");
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Checkbox("Pause", &m_paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Save trace")) {
+        writeChromeTrace(m_outputPath.empty() ? "profile_trace.json" : m_outputPath);
+    }
+    if (!m_gpuTiming) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(no GPU timer queries)");
+    }
+
+    std::vector<float> cpuMs;
+    std::vector<float> gpuMs;
+    for (const Frame& frame : m_history) {
+        cpuMs.push_back(static_cast<float>(toMs(frame.cpuEnd - frame.cpuBegin)));
+        gpuMs.push_back(frame.hasGpuTimes ? static_cast<float>(toMs(frame.gpuEnd - frame.gpuBegin)) : 0.0f);
+    }
+    const int frameCount { static_cast<int>(m_history.size()) };
+    ImGui::PlotLines("CPU ms", cpuMs.data(), frameCount, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+    if (m_gpuTiming) {
+        ImGui::PlotLines("GPU ms", gpuMs.data(), frameCount, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+    }
+
+    if (m_paused) {
+        ImGui::SliderInt("Frames back", &m_selectedFrame, 0, frameCount - 1);
+    } else {
+        m_selectedFrame = 0;
+    }
+    m_selectedFrame = std::clamp(m_selectedFrame, 0, frameCount - 1);
+    const Frame& frame { m_history[static_cast<std::size_t>(frameCount - 1 - m_selectedFrame)] };
+
+    ImGui::Separator();
+    ImGui::Text("Frame %llu   CPU %.3f ms   GPU %.3f ms", static_cast<unsigned long long>(frame.index),
+        toMs(frame.cpuEnd - frame.cpuBegin), frame.hasGpuTimes ? toMs(frame.gpuEnd - frame.gpuBegin) : 0.0);
+    drawTimeline(frame);
+
+    ImGui::Separator();
+    ImGui::Text("Flame graph, averaged over %d frames", frameCount);
+    ImGui::SameLine();
+    if (ImGui::RadioButton("GPU", m_flameShowsGpu) && m_gpuTiming) {
+        m_flameShowsGpu = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::RadioButton("CPU", !m_flameShowsGpu || !m_gpuTiming)) {
+        m_flameShowsGpu = false;
+    }
+    drawFlameGraph();
+
+    ImGui::End();
+}
+
+void Profiler::drawTimeline(const Frame& frame) const {
+    int maxDepth { -1 };
+    for (const Zone& zone : frame.zones) {
+        maxDepth = std::max(maxDepth, zone.depth);
+    }
+    // Per track: one row for the frame, one per nesting level.
+    const int trackRows { maxDepth + 2 };
+    const int trackCount { frame.hasGpuTimes ? 2 : 1 };
+
+    const std::int64_t begin { frame.cpuBegin };
+    const std::int64_t end { std::max(frame.cpuEnd, frame.hasGpuTimes ? frame.gpuEnd : frame.cpuEnd) };
+    const ImVec2 origin { ImGui::GetCursorScreenPos() };
+    const float width { std::max(ImGui::GetContentRegionAvail().x, 100.0f) };
+    const float rowHeight { ImGui::GetTextLineHeightWithSpacing() };
+    const double pixelsPerNs { width / static_cast<double>(std::max<std::int64_t>(end - begin, 1)) };
+
+    ImDrawList* drawList { ImGui::GetWindowDrawList() };
+    const auto bar = [&](const int row, const std::int64_t from, const std::int64_t to, const char* name, const ImU32 color) {
+        const float x0 { origin.x + static_cast<float>(static_cast<double>(from - begin) * pixelsPerNs) };
+        const float x1 { origin.x + static_cast<float>(static_cast<double>(to - begin) * pixelsPerNs) };
+        const float y { origin.y + static_cast<float>(row) * rowHeight };
+        drawBar(drawList, ImVec2(x0, y), ImVec2(std::max(x1, x0 + 1.0f), y + rowHeight - 1.0f), name, color,
+            toMs(to - from));
+    };
+
+    bar(0, frame.cpuBegin, frame.cpuEnd, "CPU frame", IM_COL32(60, 60, 70, 255));
+    for (const Zone& zone : frame.zones) {
+        bar(zone.depth + 1, zone.cpuBegin, zone.cpuEnd, zone.name, zoneColor(zone.name));
+    }
+    if (frame.hasGpuTimes) {
+        bar(trackRows, frame.gpuBegin, frame.gpuEnd, "GPU frame", IM_COL32(60, 70, 60, 255));
+        for (const Zone& zone : frame.zones) {
+            bar(trackRows + zone.depth + 1, zone.gpuBegin, zone.gpuEnd, zone.name, zoneColor(zone.name));
+        }
+    }
+    ImGui::Dummy(ImVec2(width, static_cast<float>(trackRows * trackCount) * rowHeight));
+}
+
+void Profiler::drawFlameGraph() const {
+    // Zones merged by call path (the names from the frame down to the zone), time averaged per frame.
+    struct Node {
+        std::uint64_t path;
+        const char* name;
+        int depth;
+        std::size_t parent;
+        double totalNs;
+        double x;
+        double nextChildX;
+    };
+
+    const bool useGpu { m_flameShowsGpu && m_gpuTiming };
+    std::vector<Node> nodes { { FNV1A_OFFSET_BASIS, "Frame", 0, 0, 0.0, 0.0, 0.0 } };
+    std::unordered_map<std::uint64_t, std::size_t> nodeByPath;
+    std::vector<std::size_t> parentAtDepth;
+    std::size_t frameCount {};
+
+    for (const Frame& frame : m_history) {
+        if (useGpu && !frame.hasGpuTimes) {
+            continue;
+        }
+        ++frameCount;
+        nodes[0].totalNs += static_cast<double>(useGpu ? frame.gpuEnd - frame.gpuBegin : frame.cpuEnd - frame.cpuBegin);
+
+        parentAtDepth.assign(1, 0);
+        for (const Zone& zone : frame.zones) {
+            // Zones are stored in begin order, so a zone's parent is the last one opened one level up.
+            const std::size_t parent { parentAtDepth[static_cast<std::size_t>(zone.depth)] };
+            // The name's terminating NUL separates it from the parent's path, so "ab" under "c" and "b" under
+            // "ca" get different paths.
+            const std::uint64_t path { fnv1a64(std::string_view(zone.name, std::strlen(zone.name) + 1),
+                nodes[parent].path) };
+            auto [it, inserted] { nodeByPath.try_emplace(path, nodes.size()) };
+            if (inserted) {
+                nodes.push_back({ path, zone.name, zone.depth + 1, parent, 0.0, 0.0, 0.0 });
+            }
+            nodes[it->second].totalNs += static_cast<double>(useGpu ? zone.gpuEnd - zone.gpuBegin : zone.cpuEnd - zone.cpuBegin);
+            parentAtDepth.resize(static_cast<std::size_t>(zone.depth) + 1);
+            parentAtDepth.push_back(it->second);
+        }
+    }
+    if (frameCount == 0 || nodes[0].totalNs <= 0.0) {
+        ImGui::TextDisabled("No frames with %s times yet.", useGpu ? "GPU" : "CPU");
+        return;
+    }
+
+    const ImVec2 origin { ImGui::GetCursorScreenPos() };
+    const float width { std::max(ImGui::GetContentRegionAvail().x, 100.0f) };
+    const float rowHeight { ImGui::GetTextLineHeightWithSpacing() };
+    const double pixelsPerNs { width / nodes[0].totalNs };
+    ImDrawList* drawList { ImGui::GetWindowDrawList() };
+
+    // Parents come before their children in nodes, so one pass can lay children out left to right.
+    int maxDepth {};
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        Node& node { nodes[i] };
+        if (i > 0) {
+            Node& parent { nodes[node.parent] };
+            node.x = parent.nextChildX;
+            parent.nextChildX += node.totalNs;
+        }
+        node.nextChildX = node.x;
+        maxDepth = std::max(maxDepth, node.depth);
+
+        const float x0 { origin.x + static_cast<float>(node.x * pixelsPerNs) };
+        const float x1 { origin.x + static_cast<float>((node.x + node.totalNs) * pixelsPerNs) };
+        const float y { origin.y + static_cast<float>(node.depth) * rowHeight };
+        drawBar(drawList, ImVec2(x0, y), ImVec2(std::max(x1, x0 + 1.0f), y + rowHeight - 1.0f), node.name,
+            i == 0 ? IM_COL32(60, 60, 70, 255) : zoneColor(node.name), node.totalNs / 1'000'000.0 / static_cast<double>(frameCount));
+    }
+    ImGui::Dummy(ImVec2(width, static_cast<float>(maxDepth + 1) * rowHeight));
+}
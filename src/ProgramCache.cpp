@@ -0,0 +1,139 @@
+#include "ProgramCache.hpp"
+#include "Hash.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+    constexpr std::uint32_t CACHE_MAGIC { 0x42474C43 }; // "CGLB"
+    constexpr std::uint32_t CACHE_VERSION { 1 };
+
+    struct EntryHeader {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t key;
+        std::uint32_t format;
+        std::uint32_t length;
+    };
+
+    std::filesystem::path defaultDirectory() {
+        const char* directory { std::getenv("COREGL_SHADER_CACHE_DIR") };
+        return directory ? std::filesystem::path(directory) : std::filesystem::path("shader_cache");
+    }
+
+    std::filesystem::path& cacheDirectory() {
+        static std::filesystem::path directory { defaultDirectory() };
+        return directory;
+    }
+
+    std::string_view glString(const GLenum name) {
+        const auto* value { reinterpret_cast<const char*>(glGetString(name)) };
+        return value ? std::string_view(value) : std::string_view();
+    }
+}
+
+void ProgramCache::setDirectory(const std::filesystem::path& directory) {
+    cacheDirectory() = directory;
+}
+
+const std::filesystem::path& ProgramCache::getDirectory() {
+    return cacheDirectory();
+}
+
+bool ProgramCache::isEnabled() {
+    if (!GLAD_GL_VERSION_4_1 || cacheDirectory().empty()) {
+        return false;
+    }
+    GLint formatCount {};
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+std::uint64_t ProgramCache::makeKey(const std::string_view vertexCode, const std::string_view fragmentCode) {
+    // Lengths go in too, so moving text from one stage to the other changes the key.
+    const std::uint64_t lengths[] { vertexCode.size(), fragmentCode.size() };
+    std::uint64_t key { fnv1a64(lengths, sizeof(lengths)) };
+    key = fnv1a64(vertexCode, key);
+    key = fnv1a64(fragmentCode, key);
+    key = fnv1a64(glString(GL_VENDOR), key);
+    key = fnv1a64(glString(GL_RENDERER), key);
+    return fnv1a64(glString(GL_VERSION), key);
+}
+
+std::filesystem::path ProgramCache::entryPath(const std::uint64_t key) {
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return cacheDirectory() / name;
+}
+
+bool ProgramCache::load(const GLuint program, const std::uint64_t key) {
+    if (!isEnabled()) {
+        return false;
+    }
+
+    std::ifstream file(entryPath(key), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    EntryHeader header {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.key != key) {
+        return false;
+    }
+    std::vector<char> binary(header.length);
+    file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    if (!file) {
+        return false;
+    }
+
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint success {};
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        // Stale after a driver change the version string did not reflect; the fresh link overwrites it.
+        std::cout << "ERROR::PROGRAM_CACHE::BINARY_REJECTED: " << entryPath(key).string() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void ProgramCache::store(const GLuint program, const std::uint64_t key) {
+    if (!isEnabled()) {
+        return;
+    }
+    GLint success {};
+    GLint length {};
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (!success || length <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(static_cast<std::size_t>(length));
+    GLenum format {};
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory(), error);
+    // Written beside the entry and renamed over it, so a concurrent reader never sees half a file.
+    const std::filesystem::path path { entryPath(key) };
+    std::filesystem::path temporary { path };
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        const EntryHeader header { CACHE_MAGIC, CACHE_VERSION, key, format, static_cast<std::uint32_t>(length) };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), length);
+        if (!file) {
+            std::cout << "ERROR::PROGRAM_CACHE::WRITE_FAILED: " << temporary.string() << std::endl;
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cout << "ERROR::PROGRAM_CACHE::WRITE_FAILED: " << path.string() << std::endl;
+        std::filesystem::remove(temporary, error);
+    }
+}
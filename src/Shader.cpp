@@ -2,10 +2,47 @@
 // Created by Keal on 4/16/2026.
 //
 #include "Shader.hpp"
+#include "ProgramCache.hpp"
+#include "GLCapabilities.hpp"
+#include "GLStateCache.hpp"
+#include "UniformBuffer.hpp"
+#include <algorithm>
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
+Shader::Shader(const char* vertexPath, const char* fragmentPath) : Shader(vertexPath, fragmentPath, DeferredLink {}) {
+    finishLink();
+}
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath, DeferredLink)
+    : m_vertexPath(vertexPath), m_fragmentPath(fragmentPath) {
     std::string vertexCode;
     std::string fragmentCode;
+    readSources(m_vertexPath, m_fragmentPath, vertexCode, fragmentCode);
+
+    m_ID = glCreateProgram();
+
+    // A cached binary skips compiling and linking entirely.
+    m_cacheKey = ProgramCache::makeKey(vertexCode, fragmentCode);
+    if (ProgramCache::load(m_ID, m_cacheKey)) {
+        cacheUniformLocations();
+        return;
+    }
+
+    submitCompile(m_ID, vertexCode.c_str(), fragmentCode.c_str(), m_vertex, m_fragment);
+    m_linkPending = true;
+}
+
+Shader::~Shader() {
+    if (m_linkPending) {
+        glDeleteShader(m_vertex);
+        glDeleteShader(m_fragment);
+    }
+    discardReload();
+    glDeleteProgram(m_ID);
+    GLStateCache::onProgramDeleted(m_ID);
+}
+
+bool Shader::readSources(const std::string& vertexPath, const std::string& fragmentPath, std::string& vertexCode,
+    std::string& fragmentCode) {
     std::ifstream vShaderFile;
     std::ifstream fShaderFile;
 
@@ -28,78 +65,403 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     }
     catch (std::ifstream::failure& e) {
         std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: " << e.what() << std::endl;
+        return false;
     }
+    return true;
+}
 
-    const char* vShaderCode = vertexCode.c_str();
-    const char* fShaderCode = fragmentCode.c_str();
-
-    GLuint vertex, fragment;
-
+// --- Compile and link ---
+void Shader::submitCompile(const GLuint program, const char* vShaderCode, const char* fShaderCode, GLuint& vertex,
+    GLuint& fragment) {
     // Vertex Shader
     vertex = glCreateShader(GL_VERTEX_SHADER);
     glShaderSource(vertex, 1, &vShaderCode, nullptr);
     glCompileShader(vertex);
-    checkCompileErrors(vertex, "VERTEX");
 
     // Fragment Shader
     fragment = glCreateShader(GL_FRAGMENT_SHADER);
     glShaderSource(fragment, 1, &fShaderCode, nullptr);
     glCompileShader(fragment);
-    checkCompileErrors(fragment, "FRAGMENT");
 
-    // Shader Program
-    m_ID = glCreateProgram();
-    glAttachShader(m_ID, vertex);
-    glAttachShader(m_ID, fragment);
-    glLinkProgram(m_ID);
+    // Shader Program. Linking straight away, without asking for the compile status, keeps the whole
+    // chain on the driver's compiler threads; statuses are only read in finishLink() / finishReload().
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    if (ProgramCache::isEnabled()) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program);
+}
+
+bool Shader::isLinkComplete() const {
+    if (!m_linkPending || !GLCapabilities::hasParallelShaderCompile()) {
+        return true; // Without the extension there is no way to ask; finishLink() just blocks.
+    }
+    GLint completed {};
+    glGetProgramiv(m_ID, GL_COMPLETION_STATUS_KHR, &completed);
+    return completed == GL_TRUE;
+}
+
+void Shader::finishLink() {
+    if (!m_linkPending) {
+        return;
+    }
+    m_linkPending = false;
+
+    checkCompileErrors(m_vertex, "VERTEX");
+    checkCompileErrors(m_fragment, "FRAGMENT");
     checkCompileErrors(m_ID, "PROGRAM");
 
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+    glDetachShader(m_ID, m_vertex);
+    glDetachShader(m_ID, m_fragment);
+    glDeleteShader(m_vertex);
+    glDeleteShader(m_fragment);
+    m_vertex = 0;
+    m_fragment = 0;
+
+    ProgramCache::store(m_ID, m_cacheKey);
+    cacheUniformLocations();
 }
 
-Shader::~Shader() {
+// --- Hot reload ---
+namespace {
+    struct ActiveUniform {
+        GLenum type;
+        GLint size;
+    };
+
+    std::unordered_map<std::string, ActiveUniform> activeUniforms(const GLuint program) {
+        std::unordered_map<std::string, ActiveUniform> uniforms;
+        GLint uniformCount {};
+        GLint maxNameLength {};
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+        std::string name(static_cast<std::size_t>(maxNameLength), '\0');
+        for (GLint i = 0; i < uniformCount; ++i) {
+            GLsizei length {};
+            ActiveUniform uniform {};
+            glGetActiveUniform(program, static_cast<GLuint>(i), maxNameLength, &length, &uniform.size, &uniform.type,
+                name.data());
+            std::string activeName(name.data(), static_cast<std::size_t>(length));
+            if (activeName.ends_with("[0]")) {
+                activeName.resize(activeName.size() - 3);
+            }
+            uniforms.emplace(std::move(activeName), uniform);
+        }
+        return uniforms;
+    }
+
+    // Copies one uniform from the old program into the bound new one. Types the exercises do not use
+    // (doubles, non-square matrices) start from their defaults.
+    void copyUniform(const GLuint from, const GLint fromLocation, const GLint toLocation, const GLenum type) {
+        GLfloat floats[16] {};
+        GLint ints[4] {};
+        GLuint uints[4] {};
+        switch (type) {
+            case GL_FLOAT:
+            case GL_FLOAT_VEC2:
+            case GL_FLOAT_VEC3:
+            case GL_FLOAT_VEC4:
+                glGetUniformfv(from, fromLocation, floats);
+                type == GL_FLOAT ? glUniform1fv(toLocation, 1, floats)
+                    : type == GL_FLOAT_VEC2 ? glUniform2fv(toLocation, 1, floats)
+                    : type == GL_FLOAT_VEC3 ? glUniform3fv(toLocation, 1, floats)
+                    : glUniform4fv(toLocation, 1, floats);
+                break;
+            case GL_FLOAT_MAT2:
+                glGetUniformfv(from, fromLocation, floats);
+                glUniformMatrix2fv(toLocation, 1, GL_FALSE, floats);
+                break;
+            case GL_FLOAT_MAT3:
+                glGetUniformfv(from, fromLocation, floats);
+                glUniformMatrix3fv(toLocation, 1, GL_FALSE, floats);
+                break;
+            case GL_FLOAT_MAT4:
+                glGetUniformfv(from, fromLocation, floats);
+                glUniformMatrix4fv(toLocation, 1, GL_FALSE, floats);
+                break;
+            case GL_INT_VEC2:
+            case GL_BOOL_VEC2:
+                glGetUniformiv(from, fromLocation, ints);
+                glUniform2iv(toLocation, 1, ints);
+                break;
+            case GL_INT_VEC3:
+            case GL_BOOL_VEC3:
+                glGetUniformiv(from, fromLocation, ints);
+                glUniform3iv(toLocation, 1, ints);
+                break;
+            case GL_INT_VEC4:
+            case GL_BOOL_VEC4:
+                glGetUniformiv(from, fromLocation, ints);
+                glUniform4iv(toLocation, 1, ints);
+                break;
+            case GL_UNSIGNED_INT:
+                glGetUniformuiv(from, fromLocation, uints);
+                glUniform1uiv(toLocation, 1, uints);
+                break;
+            case GL_UNSIGNED_INT_VEC2:
+            case GL_UNSIGNED_INT_VEC3:
+            case GL_UNSIGNED_INT_VEC4:
+                glGetUniformuiv(from, fromLocation, uints);
+                type == GL_UNSIGNED_INT_VEC2 ? glUniform2uiv(toLocation, 1, uints)
+                    : type == GL_UNSIGNED_INT_VEC3 ? glUniform3uiv(toLocation, 1, uints)
+                    : glUniform4uiv(toLocation, 1, uints);
+                break;
+            case GL_DOUBLE:
+            case GL_DOUBLE_VEC2:
+            case GL_DOUBLE_VEC3:
+            case GL_DOUBLE_VEC4:
+            case GL_FLOAT_MAT2x3:
+            case GL_FLOAT_MAT2x4:
+            case GL_FLOAT_MAT3x2:
+            case GL_FLOAT_MAT3x4:
+            case GL_FLOAT_MAT4x2:
+            case GL_FLOAT_MAT4x3:
+                break;
+            default:
+                // int, bool and every sampler / image type are set as one int.
+                glGetUniformiv(from, fromLocation, ints);
+                glUniform1iv(toLocation, 1, ints);
+                break;
+        }
+    }
+
+    // Copies every value whose name and type survived the edit. `to` must be the bound program.
+    void copyUniformValues(const GLuint from, const GLuint to) {
+        const auto previous { activeUniforms(from) };
+        for (const auto& [name, uniform] : activeUniforms(to)) {
+            const auto match { previous.find(name) };
+            if (match == previous.end() || match->second.type != uniform.type) {
+                continue;
+            }
+            const GLint count { std::min(uniform.size, match->second.size) };
+            for (GLint i = 0; i < count; ++i) {
+                const std::string element { uniform.size > 1 || match->second.size > 1
+                    ? name + "[" + std::to_string(i) + "]" : name };
+                const GLint fromLocation { glGetUniformLocation(from, element.c_str()) };
+                const GLint toLocation { glGetUniformLocation(to, element.c_str()) };
+                if (fromLocation >= 0 && toLocation >= 0) {
+                    copyUniform(from, fromLocation, toLocation, uniform.type);
+                }
+            }
+        }
+    }
+}
+
+void Shader::discardReload() {
+    if (m_reloadProgram == 0) {
+        return;
+    }
+    if (m_reloadVertex != 0) {
+        glDeleteShader(m_reloadVertex);
+        glDeleteShader(m_reloadFragment);
+    }
+    glDeleteProgram(m_reloadProgram);
+    m_reloadProgram = 0;
+    m_reloadVertex = 0;
+    m_reloadFragment = 0;
+}
+
+void Shader::reload() {
+    finishLink();
+    discardReload();
+
+    std::string vertexCode;
+    std::string fragmentCode;
+    if (!readSources(m_vertexPath, m_fragmentPath, vertexCode, fragmentCode)) {
+        return; // Mid-save or deleted: the current program stays, the next change retries.
+    }
+    m_reloadProgram = glCreateProgram();
+    m_reloadKey = ProgramCache::makeKey(vertexCode, fragmentCode);
+    if (!ProgramCache::load(m_reloadProgram, m_reloadKey)) {
+        submitCompile(m_reloadProgram, vertexCode.c_str(), fragmentCode.c_str(), m_reloadVertex, m_reloadFragment);
+    }
+}
+
+bool Shader::finishReload(const bool wait) {
+    if (m_reloadProgram == 0) {
+        return false;
+    }
+    if (m_reloadVertex != 0) {
+        if (!wait && GLCapabilities::hasParallelShaderCompile()) {
+            GLint completed {};
+            glGetProgramiv(m_reloadProgram, GL_COMPLETION_STATUS_KHR, &completed);
+            if (completed != GL_TRUE) {
+                return false;
+            }
+        }
+        // Both stages get to print their errors before either result is used.
+        const bool vertexCompiled { checkCompileErrors(m_reloadVertex, "VERTEX") };
+        const bool fragmentCompiled { checkCompileErrors(m_reloadFragment, "FRAGMENT") };
+        const bool compiled { vertexCompiled && fragmentCompiled };
+        const bool linked { compiled && checkCompileErrors(m_reloadProgram, "PROGRAM") };
+        glDetachShader(m_reloadProgram, m_reloadVertex);
+        glDetachShader(m_reloadProgram, m_reloadFragment);
+        glDeleteShader(m_reloadVertex);
+        glDeleteShader(m_reloadFragment);
+        m_reloadVertex = 0;
+        m_reloadFragment = 0;
+        if (!linked) {
+            std::cout << "ERROR::SHADER::RELOAD_FAILED: keeping the previous program for " << m_vertexPath << " + "
+                      << m_fragmentPath << std::endl;
+            discardReload();
+            return false;
+        }
+        ProgramCache::store(m_reloadProgram, m_reloadKey);
+    }
+
+    // The swap: values move over while the new program is bound, then it takes the old one's place,
+    // including as the current program if the old one was.
+    const GLuint previous { GLStateCache::getProgram() };
+    GLStateCache::useProgram(m_reloadProgram);
+    copyUniformValues(m_ID, m_reloadProgram);
     glDeleteProgram(m_ID);
+    GLStateCache::onProgramDeleted(m_ID);
+    if (previous != m_ID && previous != GLStateCache::UNKNOWN) {
+        GLStateCache::useProgram(previous);
+    }
+
+    m_ID = m_reloadProgram;
+    m_cacheKey = m_reloadKey;
+    m_reloadProgram = 0;
+    cacheUniformLocations();
+    return true;
 }
 
 void Shader::use() const {
-    glUseProgram(m_ID);
+    GLStateCache::useProgram(m_ID);
+}
+
+// --- Uniform location table ---
+void Shader::cacheUniformLocations() {
+    m_uniformLocations.clear();
+    // Block bindings are program state that a link or a cached binary starts from scratch.
+    UniformBuffer::assignBlockBindings(m_ID);
+
+    GLint uniformCount {};
+    GLint maxNameLength {};
+    glGetProgramiv(m_ID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(m_ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::string name(static_cast<std::size_t>(maxNameLength), '\0');
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLsizei length {};
+        GLint size {};
+        GLenum type {};
+        glGetActiveUniform(m_ID, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, name.data());
+
+        const std::string_view activeName(name.data(), static_cast<std::size_t>(length));
+        const GLint location { glGetUniformLocation(m_ID, name.c_str()) };
+        if (location < 0) {
+            continue; // Uniform block members have no location.
+        }
+        m_uniformLocations[fnv1a64(activeName)] = location;
+
+        // Arrays are reported once, as "name[0]": the bare name resolves to the first element as well, and
+        // every other element is looked up so "name[2]" works too.
+        if (activeName.ends_with("[0]")) {
+            const std::string_view baseName { activeName.substr(0, activeName.size() - 3) };
+            m_uniformLocations[fnv1a64(baseName)] = location;
+            std::string elementName;
+            for (GLint element = 1; element < size; ++element) {
+                elementName.assign(baseName).append("[").append(std::to_string(element)).append("]");
+                const GLint elementLocation { glGetUniformLocation(m_ID, elementName.c_str()) };
+                if (elementLocation >= 0) {
+                    m_uniformLocations[fnv1a64(elementName)] = elementLocation;
+                }
+            }
+        }
+    }
+
+    // Handles given out before a relink keep their slot and get the new location.
+    for (std::size_t slot = 0; slot < m_handleHashes.size(); ++slot) {
+        m_handleLocations[slot] = findUniform(m_handleHashes[slot]);
+    }
+}
+
+GLint Shader::findUniform(const std::uint64_t nameHash) const {
+    const auto it { m_uniformLocations.find(nameHash) };
+    return it != m_uniformLocations.end() ? it->second : -1; // -1 is silently ignored by glUniform*.
+}
+
+GLint Shader::resolveHandle(const UniformName name) const {
+    for (std::size_t slot = 0; slot < m_handleHashes.size(); ++slot) {
+        if (m_handleHashes[slot] == name.hash) {
+            return static_cast<GLint>(slot);
+        }
+    }
+    m_handleHashes.push_back(name.hash);
+    m_handleLocations.push_back(findUniform(name.hash));
+    return static_cast<GLint>(m_handleHashes.size() - 1);
 }
 
 // --- Utility functions for the Uniforms ---
-void Shader::setBool(const std::string &varName, const GLboolean value) const {
-    glUniform1i(glGetUniformLocation(m_ID, varName.c_str()), static_cast<int>(value));
+void Shader::setBool(const UniformName varName, const GLboolean value) const {
+    glUniform1i(findUniform(varName.hash), static_cast<int>(value));
+}
+
+void Shader::setInt(const UniformName varName, const GLint value) const {
+    glUniform1i(findUniform(varName.hash), value);
+}
+
+void Shader::setFloat(const UniformName varName, const GLfloat value) const {
+    glUniform1f(findUniform(varName.hash), value);
+}
+
+void Shader::setVec2(const UniformName varName, const GLfloat x, const GLfloat y) const {
+    glUniform2f(findUniform(varName.hash), x, y);
+}
+
+void Shader::setVec3(const UniformName varName, const GLfloat x, const GLfloat y, const GLfloat z) const {
+    glUniform3f(findUniform(varName.hash), x, y, z);
 }
 
-void Shader::setInt(const std::string &varName, const GLint value) const {
-    glUniform1i(glGetUniformLocation(m_ID, varName.c_str()), value);
+void Shader::setVec4(const UniformName varName, const GLfloat x, const GLfloat y, const GLfloat z, const GLfloat w) const {
+    glUniform4f(findUniform(varName.hash), x, y, z, w);
 }
 
-void Shader::setFloat(const std::string &varName, const GLfloat value) const {
-    glUniform1f(glGetUniformLocation(m_ID, varName.c_str()), value);
+void Shader::setColor(const UniformName varName, const GLfloat r, const GLfloat g, const GLfloat b) const {
+    glUniform3f(findUniform(varName.hash), r, g, b);
 }
 
-void Shader::setVec2(const std::string &varName, const GLfloat x, const GLfloat y) const {
-    glUniform2f(glGetUniformLocation(m_ID, varName.c_str()), x, y);
+void Shader::setMat4(const UniformName varName, const glm::mat4 &mat) const {
+    glUniformMatrix4fv(findUniform(varName.hash), 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+// --- Handle based setters (no lookup) ---
+GLint Shader::handleLocation(const GLint slot) const {
+    if (slot < 0 || static_cast<std::size_t>(slot) >= m_handleLocations.size()) {
+        std::cout << "ERROR::SHADER::INVALID_UNIFORM_HANDLE: slot " << slot << " in program " << m_ID << std::endl;
+        return -1; // Ignored by glUniform*.
+    }
+    return m_handleLocations[static_cast<std::size_t>(slot)];
 }
 
-void Shader::setVec3(const std::string &varName, const GLfloat x, const GLfloat y, const GLfloat z) const {
-    glUniform3f(glGetUniformLocation(m_ID, varName.c_str()), x, y, z);
+void Shader::set(const Uniform<GLint> uniform, const GLint value) const {
+    glUniform1i(handleLocation(uniform.slot), value);
 }
 
-void Shader::setVec4(const std::string &varName, const GLfloat x, const GLfloat y, const GLfloat z, const GLfloat w) const {
-    glUniform4f(glGetUniformLocation(m_ID, varName.c_str()), x, y, z, w);
+void Shader::set(const Uniform<GLfloat> uniform, const GLfloat value) const {
+    glUniform1f(handleLocation(uniform.slot), value);
 }
 
-void Shader::setColor(const std::string &varName, const GLfloat r, const GLfloat g, const GLfloat b) const {
-    glUniform3f(glGetUniformLocation(m_ID, varName.c_str()), r, g, b);
+void Shader::set(const Uniform<glm::vec2> uniform, const glm::vec2 &value) const {
+    glUniform2fv(handleLocation(uniform.slot), 1, glm::value_ptr(value));
 }
 
-void Shader::setMat4(const std::string &varName, const glm::mat4 &mat) const {
-    glUniformMatrix4fv(glGetUniformLocation(m_ID, varName.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+void Shader::set(const Uniform<glm::vec3> uniform, const glm::vec3 &value) const {
+    glUniform3fv(handleLocation(uniform.slot), 1, glm::value_ptr(value));
 }
 
-void Shader::checkCompileErrors(const GLuint shader, const std::string &type) const {
+void Shader::set(const Uniform<glm::vec4> uniform, const glm::vec4 &value) const {
+    glUniform4fv(handleLocation(uniform.slot), 1, glm::value_ptr(value));
+}
+
+void Shader::set(const Uniform<glm::mat4> uniform, const glm::mat4 &value) const {
+    glUniformMatrix4fv(handleLocation(uniform.slot), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+bool Shader::checkCompileErrors(const GLuint shader, const std::string &type) const {
     int success;
     char infoLog[1024];
     if (type != "PROGRAM") {
@@ -115,4 +477,5 @@ void Shader::checkCompileErrors(const GLuint shader, const std::string &type) co
             std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
         }
     }
-}
\ No newline at end of file
+    return success != 0;
+}
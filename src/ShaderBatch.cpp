@@ -0,0 +1,46 @@
+#include "ShaderBatch.hpp"
+#include "GLCapabilities.hpp"
+
+bool ShaderBatch::s_compilerThreadsSet { false };
+
+ShaderBatch::ShaderBatch() {
+    if (!s_compilerThreadsSet && GLCapabilities::hasParallelShaderCompile()) {
+        GLCapabilities::setMaxShaderCompilerThreads(0xFFFFFFFF);
+        s_compilerThreadsSet = true;
+    }
+}
+
+Shader& ShaderBatch::add(const char* vertexPath, const char* fragmentPath) {
+    Shader& shader { m_shaders.emplace_back(vertexPath, fragmentPath, Shader::DeferredLink {}) };
+    if (shader.isLinkPending()) {
+        ++m_pending;
+    }
+    return shader;
+}
+
+bool ShaderBatch::poll() {
+    const bool canQuery { GLCapabilities::hasParallelShaderCompile() };
+    for (Shader& shader : m_shaders) {
+        if (m_pending == 0) {
+            break;
+        }
+        if (!shader.isLinkPending() || !shader.isLinkComplete()) {
+            continue;
+        }
+        shader.finishLink();
+        --m_pending;
+        if (!canQuery) {
+            break;
+        }
+    }
+    return m_pending == 0;
+}
+
+void ShaderBatch::wait() {
+    for (Shader& shader : m_shaders) {
+        if (shader.isLinkPending()) {
+            shader.finishLink();
+        }
+    }
+    m_pending = 0;
+}
@@ -0,0 +1,167 @@
+#include "ShaderWatcher.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr std::chrono::milliseconds WAKE_INTERVAL { 100 };
+    constexpr std::chrono::milliseconds POLL_INTERVAL { 250 };
+}
+
+ShaderWatcher::ShaderWatcher() {
+#ifdef __linux__
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+    m_thread = std::thread(&ShaderWatcher::watchLoop, this);
+}
+
+ShaderWatcher::~ShaderWatcher() {
+    m_stopping = true;
+    m_thread.join();
+#ifdef __linux__
+    if (m_inotify >= 0) {
+        close(m_inotify);
+    }
+#endif
+}
+
+std::string ShaderWatcher::normalise(const std::string& path) {
+    std::error_code error;
+    const std::filesystem::path absolute { std::filesystem::absolute(path, error) };
+    return (error ? std::filesystem::path(path) : absolute).lexically_normal().string();
+}
+
+void ShaderWatcher::addFile(const std::string& path) {
+    std::lock_guard lock(m_mutex);
+#ifdef __linux__
+    if (m_inotify >= 0) {
+        // Editors often save by writing a new file and renaming it over the old one, which a watch on the
+        // file itself would lose; the directory sees both kinds of save.
+        const std::string directory { std::filesystem::path(path).parent_path().string() };
+        const int descriptor { inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) };
+        if (descriptor >= 0) {
+            m_directories[descriptor] = directory;
+            return;
+        }
+        std::cout << "ERROR::SHADER_WATCHER::WATCH_FAILED: " << directory << ", polling instead" << std::endl;
+    }
+#endif
+    std::error_code error;
+    m_writeTimes[path] = std::filesystem::last_write_time(path, error);
+}
+
+void ShaderWatcher::mirror(const std::string& sourceDirectory, const std::string& runtimeDirectory) {
+    m_mirrors.push_back({ normalise(sourceDirectory), normalise(runtimeDirectory) });
+}
+
+std::string ShaderWatcher::watchedFile(const std::string& path) {
+    const std::string runtimePath { normalise(path) };
+    for (const Mirror& mirror : m_mirrors) {
+        const std::filesystem::path relative { std::filesystem::path(runtimePath).lexically_relative(mirror.runtime) };
+        if (relative.empty() || *relative.begin() == "..") {
+            continue;
+        }
+        const std::string source { (mirror.source / relative).lexically_normal().string() };
+        if (std::filesystem::exists(source)) {
+            m_copies[source] = runtimePath;
+            return source;
+        }
+    }
+    return runtimePath;
+}
+
+void ShaderWatcher::watch(Shader& shader) {
+    WatchedShader watched { &shader, watchedFile(shader.getVertexPath()), watchedFile(shader.getFragmentPath()) };
+    addFile(watched.vertexPath);
+    addFile(watched.fragmentPath);
+    m_shaders.push_back(std::move(watched));
+}
+
+void ShaderWatcher::unwatch(const Shader& shader) {
+    // Directory watches stay; changes there just no longer match a shader.
+    std::erase_if(m_shaders, [&shader](const WatchedShader& watched) { return watched.shader == &shader; });
+}
+
+void ShaderWatcher::pollWriteTimes() {
+    std::lock_guard lock(m_mutex);
+    for (auto& [path, writeTime] : m_writeTimes) {
+        std::error_code error;
+        const auto current { std::filesystem::last_write_time(path, error) };
+        if (!error && current != writeTime) {
+            writeTime = current;
+            m_changed.insert(path);
+        }
+    }
+}
+
+void ShaderWatcher::watchLoop() {
+    auto nextPoll { std::chrono::steady_clock::now() };
+    while (!m_stopping) {
+#ifdef __linux__
+        if (m_inotify >= 0) {
+            pollfd descriptor { m_inotify, POLLIN, 0 };
+            if (poll(&descriptor, 1, static_cast<int>(WAKE_INTERVAL.count())) > 0) {
+                alignas(inotify_event) char buffer[4096];
+                ssize_t length;
+                while ((length = read(m_inotify, buffer, sizeof(buffer))) > 0) {
+                    std::lock_guard lock(m_mutex);
+                    for (const char* cursor = buffer; cursor < buffer + length;) {
+                        const auto* event { reinterpret_cast<const inotify_event*>(cursor) };
+                        const auto directory { m_directories.find(event->wd) };
+                        if (event->len > 0 && directory != m_directories.end()) {
+                            m_changed.insert((std::filesystem::path(directory->second) / event->name).string());
+                        }
+                        cursor += sizeof(inotify_event) + event->len;
+                    }
+                }
+            }
+        } else {
+            std::this_thread::sleep_for(WAKE_INTERVAL);
+        }
+#else
+        std::this_thread::sleep_for(WAKE_INTERVAL);
+#endif
+        // Files inotify could not watch, or every file without inotify.
+        if (std::chrono::steady_clock::now() >= nextPoll) {
+            pollWriteTimes();
+            nextPoll = std::chrono::steady_clock::now() + POLL_INTERVAL;
+        }
+    }
+}
+
+std::size_t ShaderWatcher::update() {
+    std::unordered_set<std::string> changed;
+    {
+        std::lock_guard lock(m_mutex);
+        changed.swap(m_changed);
+    }
+    for (const std::string& path : changed) {
+        if (const auto copy { m_copies.find(path) }; copy != m_copies.end()) {
+            std::error_code error;
+            std::filesystem::copy_file(path, copy->second, std::filesystem::copy_options::overwrite_existing, error);
+            if (error) {
+                std::cout << "ERROR::SHADER_WATCHER::COPY_FAILED: " << path << " -> " << copy->second << std::endl;
+            }
+        }
+    }
+    for (const WatchedShader& watched : m_shaders) {
+        if (changed.contains(watched.vertexPath) || changed.contains(watched.fragmentPath)) {
+            watched.shader->reload();
+        }
+    }
+
+    std::size_t swapped {};
+    for (const WatchedShader& watched : m_shaders) {
+        if (watched.shader->isReloadPending() && watched.shader->finishReload()) {
+            std::cout << "Reloaded shader: " << watched.vertexPath << " + " << watched.fragmentPath << std::endl;
+            ++swapped;
+        }
+    }
+    return swapped;
+}
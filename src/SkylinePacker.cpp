@@ -0,0 +1,99 @@
+#include "SkylinePacker.hpp"
+#include <algorithm>
+#include <limits>
+
+SkylinePacker::SkylinePacker(const int width, const int height) : m_width(width), m_height(height) {
+    reset();
+}
+
+void SkylinePacker::reset() {
+    m_skyline.assign(1, { 0, 0, m_width });
+    m_usedArea = 0;
+}
+
+int SkylinePacker::restingHeight(const std::size_t index, const int width, const int height) const {
+    const int x { m_skyline[index].x };
+    if (x + width > m_width) {
+        return -1;
+    }
+    int y { 0 };
+    int remaining { width };
+    for (std::size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) {
+            return -1;
+        }
+        remaining -= m_skyline[i].width;
+    }
+    return y;
+}
+
+SkylinePacker::Rect SkylinePacker::insert(const int width, const int height) {
+    if (width <= 0 || height <= 0) {
+        return {};
+    }
+
+    std::size_t bestIndex { m_skyline.size() };
+    int bestTop { std::numeric_limits<int>::max() };
+    long long bestWaste { std::numeric_limits<long long>::max() };
+    int bestY {};
+    for (std::size_t i = 0; i < m_skyline.size(); ++i) {
+        const int y { restingHeight(i, width, height) };
+        if (y < 0 || y + height > bestTop) {
+            continue;
+        }
+        // Area between the skyline and the rectangle's bottom, lost for good once it is placed.
+        long long waste {};
+        int remaining { width };
+        for (std::size_t j = i; remaining > 0; ++j) {
+            const int covered { std::min(remaining, m_skyline[j].width) };
+            waste += static_cast<long long>(y - m_skyline[j].y) * covered;
+            remaining -= covered;
+        }
+        if (y + height < bestTop || waste < bestWaste) {
+            bestIndex = i;
+            bestTop = y + height;
+            bestWaste = waste;
+            bestY = y;
+        }
+    }
+    if (bestIndex == m_skyline.size()) {
+        return {};
+    }
+
+    const Rect placed { m_skyline[bestIndex].x, bestY, width, height };
+    m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), { placed.x, bestTop, width });
+
+    // Shrink or drop the segments the new one now covers.
+    const int right { placed.x + width };
+    for (std::size_t i = bestIndex + 1; i < m_skyline.size();) {
+        Segment& segment { m_skyline[i] };
+        if (segment.x >= right) {
+            break;
+        }
+        const int overlap { std::min(right - segment.x, segment.width) };
+        segment.x += overlap;
+        segment.width -= overlap;
+        if (segment.width == 0) {
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            break;
+        }
+    }
+    // Neighbours at the same height become one segment.
+    for (std::size_t i = 1; i < m_skyline.size();) {
+        if (m_skyline[i - 1].y == m_skyline[i].y) {
+            m_skyline[i - 1].width += m_skyline[i].width;
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            ++i;
+        }
+    }
+
+    m_usedArea += static_cast<long long>(width) * height;
+    return placed;
+}
+
+float SkylinePacker::getOccupancy() const {
+    return static_cast<float>(static_cast<double>(m_usedArea) / (static_cast<double>(m_width) * m_height));
+}
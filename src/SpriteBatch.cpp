@@ -0,0 +1,213 @@
+#include "SpriteBatch.hpp"
+#include "GLStateCache.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+SpriteBatch::StreamChunk::StreamChunk(const GLsizeiptr regionSize, const EBO& ebo)
+    : stream(GL_ARRAY_BUFFER, regionSize) {
+    vao.setElementBuffer(ebo);
+    // Atribute 0: Position (2 floats)
+    vao.linkAttrib(stream, 0, 2, GL_FLOAT, STRIDE, nullptr);
+    // Atribute 1: Color (3 floats)
+    vao.linkAttrib(stream, 1, 3, GL_FLOAT, STRIDE, reinterpret_cast<void*>(2 * sizeof(GLfloat)));
+    // Atribute 2: Texture (2 floats)
+    vao.linkAttrib(stream, 2, 2, GL_FLOAT, STRIDE, reinterpret_cast<void*>(5 * sizeof(GLfloat)));
+    // Atribute 3: Texture array layer or bindless slot (1 float, exact up to 2^24)
+    vao.linkAttrib(stream, 3, 1, GL_FLOAT, STRIDE, reinterpret_cast<void*>(7 * sizeof(GLfloat)));
+    VAO::unbind();
+}
+
+SpriteBatch::SpriteBatch(const std::size_t capacity)
+    : m_capacity(capacity),
+      m_EBO(makeQuadIndices(capacity).data(), static_cast<GLsizeiptr>(capacity * 6 * sizeof(GLuint))) {
+    m_vertices.reserve(capacity * FLOATS_PER_SPRITE);
+    m_materials.reserve(capacity);
+    m_order.reserve(capacity);
+
+    // A full batch plus alignment padding fits every region.
+    m_chunks.push_back(std::make_unique<StreamChunk>(
+        static_cast<GLsizeiptr>(capacity * FLOATS_PER_SPRITE * sizeof(GLfloat) + STRIDE), m_EBO));
+}
+
+std::vector<GLuint> SpriteBatch::makeQuadIndices(const std::size_t capacity) {
+    // Every quad uses the same pattern; glDrawElementsBaseVertex moves it to the run's first vertex.
+    std::vector<GLuint> indices(capacity * 6);
+    for (std::size_t quad = 0; quad < capacity; ++quad) {
+        const auto first { static_cast<GLuint>(quad * 4) };
+        GLuint* index { &indices[quad * 6] };
+        index[0] = first;
+        index[1] = first + 1;
+        index[2] = first + 2;
+        index[3] = first;
+        index[4] = first + 2;
+        index[5] = first + 3;
+    }
+    return indices;
+}
+
+GLfloat* SpriteBatch::pushSprite(const Material& material, const std::uint32_t textureKey) {
+    if (m_materials.size() >= m_capacity) {
+        flush(); // The shared index buffer only covers m_capacity quads per draw.
+    }
+    const std::uint64_t key { static_cast<std::uint64_t>(material.shader->getID()) << 32 | textureKey };
+    m_order.emplace_back(key, static_cast<std::uint32_t>(m_materials.size()));
+    m_materials.push_back(material);
+
+    const std::size_t offset { m_vertices.size() };
+    m_vertices.resize(offset + FLOATS_PER_SPRITE);
+    return &m_vertices[offset];
+}
+
+void SpriteBatch::writeVertex(GLfloat* vertex, const GLfloat x, const GLfloat y, const glm::vec3& color,
+    const GLfloat u, const GLfloat v, const GLfloat layer) {
+    vertex[0] = x;
+    vertex[1] = y;
+    vertex[2] = color.x;
+    vertex[3] = color.y;
+    vertex[4] = color.z;
+    vertex[5] = u;
+    vertex[6] = v;
+    vertex[7] = layer;
+}
+
+void SpriteBatch::writeQuad(GLfloat* vertex, const glm::mat4& transform, const glm::vec3& color,
+    const glm::vec4& uvRect, const GLfloat layer) {
+    // Only the 2D part of the matrix matters for a quad lying on z = 0.
+    const GLfloat ax { transform[0][0] }, ay { transform[0][1] };
+    const GLfloat bx { transform[1][0] }, by { transform[1][1] };
+    const GLfloat tx { transform[3][0] }, ty { transform[3][1] };
+    const auto corner { [&](const GLfloat x, const GLfloat y, const GLfloat u, const GLfloat v) {
+        writeVertex(vertex, ax * x + bx * y + tx, ay * x + by * y + ty, color, u, v, layer);
+        vertex += FLOATS_PER_VERTEX;
+    } };
+    corner(-0.5f, -0.5f, uvRect.x, uvRect.w);
+    corner( 0.5f, -0.5f, uvRect.z, uvRect.w);
+    corner( 0.5f,  0.5f, uvRect.z, uvRect.y);
+    corner(-0.5f,  0.5f, uvRect.x, uvRect.y);
+}
+
+void SpriteBatch::writeQuad(GLfloat* vertex, const glm::vec2& position, const glm::vec2& size, const GLfloat rotation,
+    const glm::vec3& color, const glm::vec4& uvRect, const GLfloat layer) {
+    const GLfloat c { std::cos(rotation) }, s { std::sin(rotation) };
+    const GLfloat hx { 0.5f * size.x }, hy { 0.5f * size.y };
+    const auto corner { [&](const GLfloat x, const GLfloat y, const GLfloat u, const GLfloat v) {
+        writeVertex(vertex, position.x + c * x - s * y, position.y + s * x + c * y, color, u, v, layer);
+        vertex += FLOATS_PER_VERTEX;
+    } };
+    corner(-hx, -hy, uvRect.x, uvRect.w);
+    corner( hx, -hy, uvRect.z, uvRect.w);
+    corner( hx,  hy, uvRect.z, uvRect.y);
+    corner(-hx,  hy, uvRect.x, uvRect.y);
+}
+
+void SpriteBatch::draw(const Shader& shader, const Texture& texture, const glm::mat4& transform,
+    const glm::vec3& color, const glm::vec4& uvRect) {
+    const Material material { &shader, texture.getType(), texture.getID(), nullptr };
+    writeQuad(pushSprite(material, texture.getID()), transform, color, uvRect, 0.0f);
+}
+
+void SpriteBatch::draw(const Shader& shader, const Texture& texture, const glm::vec2& position, const glm::vec2& size,
+    const GLfloat rotation, const glm::vec3& color, const glm::vec4& uvRect) {
+    const Material material { &shader, texture.getType(), texture.getID(), nullptr };
+    writeQuad(pushSprite(material, texture.getID()), position, size, rotation, color, uvRect, 0.0f);
+}
+
+void SpriteBatch::draw(const Shader& shader, const TextureArray& textureArray, const GLint layer,
+    const glm::mat4& transform, const glm::vec3& color, const glm::vec4& uvRect) {
+    const Material material { &shader, GL_TEXTURE_2D_ARRAY, textureArray.getID(), nullptr };
+    writeQuad(pushSprite(material, textureArray.getID()), transform, color, uvRect, static_cast<GLfloat>(layer));
+}
+
+void SpriteBatch::draw(const Shader& shader, const TextureArray& textureArray, const GLint layer,
+    const glm::vec2& position, const glm::vec2& size, const GLfloat rotation, const glm::vec3& color,
+    const glm::vec4& uvRect) {
+    const Material material { &shader, GL_TEXTURE_2D_ARRAY, textureArray.getID(), nullptr };
+    writeQuad(pushSprite(material, textureArray.getID()), position, size, rotation, color, uvRect,
+        static_cast<GLfloat>(layer));
+}
+
+// Tables are keyed by their buffer with the top bit set, so they never share a run with a texture name.
+void SpriteBatch::draw(const Shader& shader, BindlessTextureTable& table, const std::uint32_t slot,
+    const glm::mat4& transform, const glm::vec3& color, const glm::vec4& uvRect) {
+    const Material material { &shader, 0, 0, &table };
+    writeQuad(pushSprite(material, 0x80000000u | table.getBufferID()), transform, color, uvRect,
+        static_cast<GLfloat>(slot));
+}
+
+void SpriteBatch::draw(const Shader& shader, BindlessTextureTable& table, const std::uint32_t slot,
+    const glm::vec2& position, const glm::vec2& size, const GLfloat rotation, const glm::vec3& color,
+    const glm::vec4& uvRect) {
+    const Material material { &shader, 0, 0, &table };
+    writeQuad(pushSprite(material, 0x80000000u | table.getBufferID()), position, size, rotation, color, uvRect,
+        static_cast<GLfloat>(slot));
+}
+
+void SpriteBatch::flush() {
+    if (m_order.empty()) {
+        return;
+    }
+
+    // Submission order is kept among equal keys, so overlapping sprites of one material stay stable.
+    if (!std::is_sorted(m_order.begin(), m_order.end())) {
+        std::sort(m_order.begin(), m_order.end());
+    }
+
+    const auto spriteBytes { static_cast<GLsizeiptr>(FLOATS_PER_SPRITE * sizeof(GLfloat)) };
+    const GLsizeiptr batchBytes { spriteBytes * static_cast<GLsizeiptr>(m_order.size()) };
+    if (batchBytes + STRIDE > m_chunks[m_chunk]->stream.getFreeBytes()) {
+        // This frame filled the chunk's region: go on in the next chunk, which a full batch always fits.
+        // Retiring the region instead would wait on fences this same frame has set.
+        if (++m_chunk == m_chunks.size()) {
+            m_chunks.push_back(std::make_unique<StreamChunk>(m_chunks.front()->stream.getRegionSize(), m_EBO));
+        }
+    }
+    StreamChunk& chunk { *m_chunks[m_chunk] };
+    const StreamBuffer::Allocation allocation { chunk.stream.allocate(batchBytes, STRIDE) };
+    if (!allocation.data) {
+        std::cout << "ERROR::SPRITE_BATCH::OUT_OF_STREAM_SPACE: " << m_order.size() << " sprites dropped" << std::endl;
+    } else {
+        auto* destination { static_cast<GLfloat*>(allocation.data) };
+        for (const auto& [key, sprite] : m_order) {
+            std::memcpy(destination, &m_vertices[sprite * FLOATS_PER_SPRITE], static_cast<std::size_t>(spriteBytes));
+            destination += FLOATS_PER_SPRITE;
+        }
+        chunk.stream.flush();
+
+        const auto firstVertex { static_cast<GLint>(allocation.offset / STRIDE) };
+        chunk.vao.bind();
+        std::size_t runStart { 0 };
+        while (runStart < m_order.size()) {
+            std::size_t runEnd { runStart + 1 };
+            while (runEnd < m_order.size() && m_order[runEnd].first == m_order[runStart].first) {
+                ++runEnd;
+            }
+
+            const Material& material { m_materials[m_order[runStart].second] };
+            material.shader->use();
+            if (material.table) {
+                material.table->bind(TEXTURE_HANDLE_BINDING);
+            } else {
+                GLStateCache::bindTexture(GL_TEXTURE0, material.target, material.texture);
+            }
+            glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>((runEnd - runStart) * 6), m_EBO.getIndexType(),
+                nullptr, firstVertex + static_cast<GLint>(runStart * 4));
+            ++m_drawCalls;
+            runStart = runEnd;
+        }
+    }
+
+    m_vertices.clear();
+    m_materials.clear();
+    m_order.clear();
+}
+
+void SpriteBatch::end() {
+    flush();
+    for (std::size_t i = 0; i <= m_chunk; ++i) {
+        m_chunks[i]->stream.endFrame();
+    }
+    m_chunk = 0;
+    m_drawCalls = 0;
+}
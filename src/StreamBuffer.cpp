@@ -0,0 +1,114 @@
+#include "StreamBuffer.hpp"
+#include "GLStateCache.hpp"
+#include <iostream>
+
+StreamBuffer::StreamBuffer(const GLenum target, const GLsizeiptr regionSize)
+    : m_target(target), m_regionSize(regionSize), m_persistent(GLAD_GL_VERSION_4_4) {
+    glGenBuffers(1, &m_ID);
+    bind();
+
+    if (m_persistent) {
+        constexpr GLbitfield flags { GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+        const GLsizeiptr totalSize { m_regionSize * REGION_COUNT };
+        glBufferStorage(m_target, totalSize, nullptr, flags);
+        m_mappedData = static_cast<GLubyte*>(glMapBufferRange(m_target, 0, totalSize, flags));
+        if (!m_mappedData) {
+            // Immutable storage cannot be respecified: start over with a plain buffer and orphan it instead.
+            std::cout << "ERROR::STREAM_BUFFER::PERSISTENT_MAP_FAILED: falling back to orphaning" << std::endl;
+            m_persistent = false;
+            GLStateCache::bindBuffer(m_target, 0);
+            glDeleteBuffers(1, &m_ID);
+            GLStateCache::onBufferDeleted(m_ID);
+            glGenBuffers(1, &m_ID);
+            bind();
+        }
+    }
+    if (!m_persistent) {
+        glBufferData(m_target, m_regionSize, nullptr, GL_STREAM_DRAW);
+    }
+    // Left bound, a pixel unpack or element buffer would change the meaning of unrelated calls.
+    GLStateCache::bindBuffer(m_target, 0);
+}
+
+StreamBuffer::~StreamBuffer() {
+    for (const GLsync fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+        }
+    }
+    if (m_mappedData) {
+        bind();
+        glUnmapBuffer(m_target);
+        GLStateCache::bindBuffer(m_target, 0);
+    }
+    glDeleteBuffers(1, &m_ID);
+    GLStateCache::onBufferDeleted(m_ID);
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate(const GLsizeiptr size, const GLsizeiptr alignment) {
+    const GLintptr base { regionBase() };
+    const GLintptr aligned { (base + m_cursor + alignment - 1) / alignment * alignment };
+    if (aligned + size > base + m_regionSize) {
+        std::cout << "ERROR::STREAM_BUFFER::REGION_FULL: " << size << " bytes requested" << std::endl;
+        return {};
+    }
+
+    if (!m_persistent && !m_mappedData) {
+        bind();
+        if (m_cursor == 0) {
+            // First write of the frame: hand the old storage back to the driver instead of waiting on it.
+            glBufferData(m_target, m_regionSize, nullptr, GL_STREAM_DRAW);
+        }
+        // Later mappings of the same frame only touch bytes the GPU has not been given yet.
+        m_mappedOffset = aligned;
+        m_mappedData = static_cast<GLubyte*>(glMapBufferRange(m_target, aligned, m_regionSize - aligned,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+        GLStateCache::bindBuffer(m_target, 0);
+        if (!m_mappedData) {
+            std::cout << "ERROR::STREAM_BUFFER::MAP_FAILED" << std::endl;
+            return {};
+        }
+    }
+
+    m_cursor = aligned + size - base;
+    const GLintptr mappedOffset { m_persistent ? 0 : m_mappedOffset };
+    return { m_mappedData + (aligned - mappedOffset), aligned };
+}
+
+void StreamBuffer::flush() {
+    if (!m_persistent && m_mappedData) {
+        bind();
+        glUnmapBuffer(m_target);
+        GLStateCache::bindBuffer(m_target, 0);
+        m_mappedData = nullptr;
+    }
+    // Persistent storage is coherent: writes are visible to the GPU without any call.
+}
+
+void StreamBuffer::endFrame() {
+    flush();
+    m_cursor = 0;
+    if (!m_persistent) {
+        return;
+    }
+
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_region = (m_region + 1) % REGION_COUNT;
+
+    if (GLsync& fence { m_fences[m_region] }) {
+        GLbitfield waitFlags { GL_SYNC_FLUSH_COMMANDS_BIT };
+        while (true) {
+            const GLenum result { glClientWaitSync(fence, waitFlags, 1'000'000) }; // 1 ms
+            if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED) {
+                break;
+            }
+            waitFlags = 0;
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+void StreamBuffer::bind() const {
+    GLStateCache::bindBuffer(m_target, m_ID);
+}
@@ -3,68 +3,279 @@
 //
 
 #include "Texture.hpp"
+#include "GLStateCache.hpp"
+#include "GLCapabilities.hpp"
+#include "ImageCache.hpp"
+#include <algorithm>
 #include <iostream>
 
 Texture::Texture(const char* texturePath, const GLenum texType, const GLenum unit) {
     m_type = texType;
-    glGenTextures(1, &m_ID);
+    createObject();
 
     bind(unit);
 
-    setWrappingMode(GL_REPEAT);
-    setFilteringMode(GL_LINEAR);
+    if (CompressedImage::isCompressedPath(texturePath)) {
+        if (!upload(CompressedImage::load(texturePath))) {
+            std::cout << "Failed to load texture: " << texturePath << std::endl;
+        }
+        return;
+    }
+
+    const MipChain mips { ImageCache::decode(texturePath) };
+    if (mips.empty()) {
+        std::cout << "Failed to load texture: " << texturePath << std::endl;
+        return;
+    }
+    upload(mips);
+}
+
+Texture::Texture(const GLenum texType, const bool placeholder) {
+    m_type = texType;
+    createObject();
+    if (!placeholder) {
+        return;
+    }
+
+    // Mutable, so the real image's immutable storage still goes into this same object.
+    constexpr GLubyte PLACEHOLDER[4] { 128, 128, 128, 255 };
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    GLStateCache::bindTexture(m_type, m_ID);
+    glTexImage2D(m_type, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER);
+    m_width = 1;
+    m_height = 1;
+}
+
+Texture::~Texture() {
+    glDeleteTextures(1, &m_ID);
+    GLStateCache::onTextureDeleted(m_ID);
+}
+
+void Texture::createObject() {
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glCreateTextures(m_type, 1, &m_ID);
+    } else {
+        glGenTextures(1, &m_ID);
+        GLStateCache::bindTexture(m_type, m_ID);
+    }
+    m_storageFormat = 0;
+    applyParameters();
+}
 
-    stbi_set_flip_vertically_on_load(true); // Flip texture vertically to match OpenGL's coordinate system
-    int numChannels;
-    GLubyte* data { stbi_load(texturePath, &m_width, &m_height, &numChannels,
-        STBI_default)};
+void Texture::applyParameters() const {
+    // With a mip chain uploaded, minification samples it whatever the filter.
+    const GLint minFilter { m_levels <= 1 ? m_filterMode
+        : m_filterMode == GL_NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR };
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glTextureParameteri(m_ID, GL_TEXTURE_WRAP_S, m_wrapMode);
+        glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, m_wrapMode);
+        glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, m_filterMode);
+        return;
+    }
+    GLStateCache::bindTexture(m_type, m_ID);
+    glTexParameteri(m_type, GL_TEXTURE_WRAP_S, m_wrapMode);
+    glTexParameteri(m_type, GL_TEXTURE_WRAP_T, m_wrapMode);
+    glTexParameteri(m_type, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(m_type, GL_TEXTURE_MAG_FILTER, m_filterMode);
+}
 
-    GLint format {};
+GLenum Texture::formatForChannels(const int numChannels) {
     switch (numChannels) {
         case 1:
-            format = GL_RED; break;
+            return GL_RED;
         case 2:
-            format = GL_RG; break;
+            return GL_RG;
         case 3:
-            format = GL_RGB; break;
+            return GL_RGB;
         case 4:
-            format = GL_RGBA; break;
+            return GL_RGBA;
         default:
             std::cerr << "Unsupported number of channels: " << numChannels << std::endl;
-            stbi_image_free(data);
+            return 0;
     }
+}
 
-    if (data) {
-        glTexImage2D(m_type, 0, format, m_width, m_height, 0, format, GL_UNSIGNED_BYTE,
-            data);
-        glGenerateMipmap(m_type);
+GLenum Texture::sizedFormatForChannels(const int numChannels) {
+    switch (numChannels) {
+        case 1:
+            return GL_R8;
+        case 2:
+            return GL_RG8;
+        case 3:
+            return GL_RGB8;
+        case 4:
+            return GL_RGBA8;
+        default:
+            return 0;
+    }
+}
+
+GLsizei Texture::mipLevelCount(const GLsizei width, const GLsizei height) {
+    GLsizei levels { 1 };
+    for (GLsizei size { std::max(width, height) }; size > 1; size /= 2) {
+        ++levels;
+    }
+    return levels;
+}
+
+bool Texture::hasImmutableStorage() {
+    return GLCapabilities::hasDirectStateAccess() || GLAD_GL_VERSION_4_2;
+}
+
+void Texture::allocateStorage(const GLsizei width, const GLsizei height, const GLsizei levels,
+    const GLenum sizedFormat) {
+    const bool sameStorage { m_storageFormat == sizedFormat && m_width == width && m_height == height
+        && m_levels == levels };
+    if (m_storageFormat != 0 && sameStorage) {
+        return;
+    }
+    const bool levelsChanged { m_levels != levels };
+    m_width = width;
+    m_height = height;
+    m_levels = levels;
+    if (m_storageFormat != 0) {
+        // Immutable storage cannot be resized: swap in a fresh object with the same parameters.
+        glDeleteTextures(1, &m_ID);
+        GLStateCache::onTextureDeleted(m_ID);
+        createObject();
+    } else if (levelsChanged) {
+        applyParameters(); // The min filter follows the level count.
+    }
+    if (!hasImmutableStorage()) {
+        // Mutable levels are specified one by one; a chain that stops early must say so to be complete.
+        GLStateCache::bindTexture(m_type, m_ID);
+        glTexParameteri(m_type, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        return;
+    }
+
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glTextureStorage2D(m_ID, levels, sizedFormat, width, height);
     } else {
-        std::cout << "Failed to load texture: " << texturePath << std::endl;
+        GLStateCache::bindTexture(m_type, m_ID);
+        glTexStorage2D(m_type, levels, sizedFormat, width, height);
     }
-    stbi_image_free(data);
+    m_storageFormat = sizedFormat;
 }
 
-Texture::~Texture() {
-    glDeleteTextures(1, &m_ID);
+void Texture::uploadLevel(const GLint level, const GLsizei width, const GLsizei height, const int numChannels,
+    const void* pixels) const {
+    const GLenum format { formatForChannels(numChannels) };
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glTextureSubImage2D(m_ID, level, 0, 0, width, height, format, GL_UNSIGNED_BYTE, pixels);
+        return;
+    }
+    GLStateCache::bindTexture(m_type, m_ID);
+    if (m_storageFormat != 0) {
+        glTexSubImage2D(m_type, level, 0, 0, width, height, format, GL_UNSIGNED_BYTE, pixels);
+    } else {
+        glTexImage2D(m_type, level, static_cast<GLint>(sizedFormatForChannels(numChannels)), width, height, 0,
+            format, GL_UNSIGNED_BYTE, pixels);
+    }
+}
+
+void Texture::upload(const void* pixels, const GLsizei width, const GLsizei height, const int numChannels) {
+    if (!formatForChannels(numChannels)) {
+        return;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Rows of 1 and 3 channel images are not 4-byte aligned.
+
+    allocateStorage(width, height, mipLevelCount(width, height), sizedFormatForChannels(numChannels));
+    uploadLevel(0, width, height, numChannels, pixels);
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glGenerateTextureMipmap(m_ID);
+    } else {
+        GLStateCache::bindTexture(m_type, m_ID);
+        glGenerateMipmap(m_type);
+    }
+}
+
+void Texture::upload(const MipChain& mips, const void* base) {
+    if (mips.empty() || !formatForChannels(mips.getNumChannels())) {
+        return;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    const MipChain::Level& top { mips.getLevels().front() };
+    allocateStorage(top.width, top.height, static_cast<GLsizei>(mips.getLevels().size()),
+        sizedFormatForChannels(mips.getNumChannels()));
+    const auto* data { static_cast<const GLubyte*>(base) };
+    for (std::size_t i = 0; i < mips.getLevels().size(); ++i) {
+        const MipChain::Level& level { mips.getLevels()[i] };
+        uploadLevel(static_cast<GLint>(i), level.width, level.height, mips.getNumChannels(), data + level.offset);
+    }
+}
+
+void Texture::allocate(const GLsizei width, const GLsizei height, const GLsizei levels, const int numChannels) {
+    if (!formatForChannels(numChannels)) {
+        return;
+    }
+    allocateStorage(width, height, levels, sizedFormatForChannels(numChannels));
+    if (m_storageFormat == 0) {
+        for (GLint level = 0; level < levels; ++level) {
+            uploadLevel(level, std::max(1, width >> level), std::max(1, height >> level), numChannels, nullptr);
+        }
+    }
+}
+
+void Texture::uploadRegion(const GLint level, const GLint x, const GLint y, const GLsizei width, const GLsizei height,
+    const int numChannels, const void* pixels) const {
+    const GLenum format { formatForChannels(numChannels) };
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glTextureSubImage2D(m_ID, level, x, y, width, height, format, GL_UNSIGNED_BYTE, pixels);
+        return;
+    }
+    GLStateCache::bindTexture(m_type, m_ID);
+    glTexSubImage2D(m_type, level, x, y, width, height, format, GL_UNSIGNED_BYTE, pixels);
+}
+
+bool Texture::upload(const CompressedImage& image, const void* base) {
+    if (image.empty()) {
+        return false;
+    }
+    const GLenum format { image.getInternalFormat() };
+    if (!GLCapabilities::hasCompressedFormat(format)) {
+        std::cout << "ERROR::TEXTURE::COMPRESSED_FORMAT_NOT_SUPPORTED: 0x" << std::hex << format << std::dec
+                  << std::endl;
+        return false;
+    }
+
+    const CompressedImage::Level& top { image.getLevels().front() };
+    allocateStorage(top.width, top.height, static_cast<GLsizei>(image.getLevels().size()), format);
+    const auto* data { static_cast<const GLubyte*>(base) };
+    for (std::size_t i = 0; i < image.getLevels().size(); ++i) {
+        const CompressedImage::Level& mip { image.getLevels()[i] };
+        const auto level { static_cast<GLint>(i) };
+        const auto size { static_cast<GLsizei>(mip.size) };
+        if (GLCapabilities::hasDirectStateAccess()) {
+            glCompressedTextureSubImage2D(m_ID, level, 0, 0, mip.width, mip.height, format, size, data + mip.offset);
+            continue;
+        }
+        GLStateCache::bindTexture(m_type, m_ID);
+        if (m_storageFormat != 0) {
+            glCompressedTexSubImage2D(m_type, level, 0, 0, mip.width, mip.height, format, size, data + mip.offset);
+        } else {
+            glCompressedTexImage2D(m_type, level, format, mip.width, mip.height, 0, size, data + mip.offset);
+        }
+    }
+    return true;
 }
 
 void Texture::bind(const GLenum textureUnit) const {
-    glActiveTexture(textureUnit);
-    glBindTexture(m_type, m_ID);
+    GLStateCache::bindTexture(textureUnit, m_type, m_ID);
 }
 
 void Texture::unbind() const {
-    glBindTexture(m_type, 0);
+    GLStateCache::bindTexture(m_type, 0);
 }
 
 void Texture::setWrappingMode(const GLint wrapMode) const {
-    glBindTexture(m_type, m_ID);
-    glTexParameteri(m_type, GL_TEXTURE_WRAP_S, wrapMode);
-    glTexParameteri(m_type, GL_TEXTURE_WRAP_T, wrapMode);
+    m_wrapMode = wrapMode;
+    applyParameters();
 }
 
 void Texture::setFilteringMode(const GLint filterMode) const {
-    glBindTexture(m_type, m_ID);
-    glTexParameteri(m_type, GL_TEXTURE_MIN_FILTER, filterMode);
-    glTexParameteri(m_type, GL_TEXTURE_MAG_FILTER, filterMode);
+    m_filterMode = filterMode;
+    applyParameters();
 }
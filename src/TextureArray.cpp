@@ -0,0 +1,140 @@
+#include "TextureArray.hpp"
+#include "Texture.hpp"
+#include "GLStateCache.hpp"
+#include "GLCapabilities.hpp"
+#include "ImageCache.hpp"
+#include <algorithm>
+#include <iostream>
+
+TextureArray::TextureArray(const GLsizei width, const GLsizei height, const GLsizei capacity, const int numChannels,
+    const GLsizei levels)
+    : m_width(width), m_height(height), m_capacity(capacity),
+      m_levels(levels > 0 ? std::min(levels, Texture::mipLevelCount(width, height))
+                          : Texture::mipLevelCount(width, height)),
+      m_numChannels(numChannels) {
+    const GLenum sizedFormat { Texture::sizedFormatForChannels(numChannels) };
+    if (!sizedFormat || width <= 0 || height <= 0 || capacity <= 0) {
+        std::cout << "ERROR::TEXTURE_ARRAY::INVALID_SIZE: " << width << "x" << height << "x" << capacity
+                  << ", " << numChannels << " channels" << std::endl;
+        m_capacity = 0;
+        return;
+    }
+
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_ID);
+        glTextureStorage3D(m_ID, m_levels, sizedFormat, width, height, capacity);
+    } else {
+        glGenTextures(1, &m_ID);
+        GLStateCache::bindTexture(GL_TEXTURE_2D_ARRAY, m_ID);
+        if (GLAD_GL_VERSION_4_2) {
+            glTexStorage3D(GL_TEXTURE_2D_ARRAY, m_levels, sizedFormat, width, height, capacity);
+        } else {
+            // Each mutable level holds every layer; they are all specified now and filled by addLayer().
+            for (GLint level = 0; level < m_levels; ++level) {
+                glTexImage3D(GL_TEXTURE_2D_ARRAY, level, static_cast<GLint>(sizedFormat), std::max(1, width >> level),
+                    std::max(1, height >> level), capacity, 0, Texture::formatForChannels(numChannels),
+                    GL_UNSIGNED_BYTE, nullptr);
+            }
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, m_levels - 1);
+        }
+    }
+    applyParameters();
+}
+
+TextureArray::~TextureArray() {
+    glDeleteTextures(1, &m_ID);
+    GLStateCache::onTextureDeleted(m_ID);
+}
+
+void TextureArray::applyParameters() const {
+    // Layers carry their mips, so minification uses them whatever the filter.
+    const GLint minFilter { m_levels == 1 ? m_filterMode
+        : m_filterMode == GL_NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR };
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glTextureParameteri(m_ID, GL_TEXTURE_WRAP_S, m_wrapMode);
+        glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, m_wrapMode);
+        glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, m_filterMode);
+        return;
+    }
+    GLStateCache::bindTexture(GL_TEXTURE_2D_ARRAY, m_ID);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, m_wrapMode);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, m_wrapMode);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_filterMode);
+}
+
+void TextureArray::uploadLevel(const GLint level, const GLint layer, const GLsizei width, const GLsizei height,
+    const void* pixels) const {
+    const GLenum format { Texture::formatForChannels(m_numChannels) };
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glTextureSubImage3D(m_ID, level, 0, 0, layer, width, height, 1, format, GL_UNSIGNED_BYTE, pixels);
+        return;
+    }
+    GLStateCache::bindTexture(GL_TEXTURE_2D_ARRAY, m_ID);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1, format, GL_UNSIGNED_BYTE, pixels);
+}
+
+void TextureArray::setLayer(const GLint layer, const MipChain& mips) const {
+    if (layer < 0 || layer >= m_capacity || mips.empty() || mips.getNumChannels() != m_numChannels
+        || mips.getLevels().front().width != m_width || mips.getLevels().front().height != m_height) {
+        std::cout << "ERROR::TEXTURE_ARRAY::LAYER_MISMATCH: layer " << layer << std::endl;
+        return;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Rows of 1 and 3 channel images are not 4-byte aligned.
+    const auto levels { std::min(static_cast<GLsizei>(mips.getLevels().size()), m_levels) };
+    for (GLint i = 0; i < levels; ++i) {
+        const MipChain::Level& level { mips.getLevels()[i] };
+        uploadLevel(i, layer, level.width, level.height, mips.getData() + level.offset);
+    }
+}
+
+GLint TextureArray::addLayer(const GLubyte* pixels, const GLsizei width, const GLsizei height, const int numChannels) {
+    if (m_layerCount >= m_capacity) {
+        std::cout << "ERROR::TEXTURE_ARRAY::FULL: " << m_capacity << " layers" << std::endl;
+        return -1;
+    }
+    if (!pixels || width != m_width || height != m_height || numChannels != m_numChannels) {
+        std::cout << "ERROR::TEXTURE_ARRAY::IMAGE_MISMATCH: " << width << "x" << height << ", " << numChannels
+                  << " channels for a " << m_width << "x" << m_height << ", " << m_numChannels << " channel array"
+                  << std::endl;
+        return -1;
+    }
+    const GLint layer { m_layerCount++ };
+    setLayer(layer, MipChain::build(pixels, width, height, numChannels, numChannels >= 3, m_levels));
+    return layer;
+}
+
+GLint TextureArray::addLayer(const char* path) {
+    const MipChain mips { ImageCache::decode(path, m_numChannels) };
+    if (mips.empty()) {
+        std::cout << "Failed to load texture: " << path << std::endl;
+        return -1;
+    }
+    const MipChain::Level& top { mips.getLevels().front() };
+    if (m_layerCount >= m_capacity || top.width != m_width || top.height != m_height) {
+        // Same messages as for raw pixels.
+        return addLayer(mips.getData(), top.width, top.height, m_numChannels);
+    }
+    const GLint layer { m_layerCount++ };
+    setLayer(layer, mips);
+    return layer;
+}
+
+void TextureArray::bind(const GLenum textureUnit) const {
+    GLStateCache::bindTexture(textureUnit, GL_TEXTURE_2D_ARRAY, m_ID);
+}
+
+void TextureArray::unbind() const {
+    GLStateCache::bindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TextureArray::setWrappingMode(const GLint wrapMode) {
+    m_wrapMode = wrapMode;
+    applyParameters();
+}
+
+void TextureArray::setFilteringMode(const GLint filterMode) {
+    m_filterMode = filterMode;
+    applyParameters();
+}
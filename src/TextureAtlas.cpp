@@ -0,0 +1,120 @@
+#include "TextureAtlas.hpp"
+#include "ImageCache.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+TextureAtlas::TextureAtlas(const GLsizei pageSize, const GLsizei mipLevels)
+    : m_pageSize(pageSize), m_mipLevels(std::clamp(mipLevels, 1, Texture::mipLevelCount(pageSize, pageSize))) {}
+
+GLsizei TextureAtlas::gutterForLevels(const GLsizei mipLevels) {
+    return 1 << (std::max(mipLevels, 1) - 1);
+}
+
+TextureAtlas::Page& TextureAtlas::openPage() {
+    const GLsizei cells { m_pageSize / gutterForLevels(m_mipLevels) };
+    Page page { std::make_unique<Texture>(GL_TEXTURE_2D, false), SkylinePacker(cells, cells) };
+    page.texture->allocate(m_pageSize, m_pageSize, m_mipLevels, 4);
+    page.texture->setWrappingMode(GL_CLAMP_TO_EDGE);
+    m_pages.push_back(std::move(page));
+    return m_pages.back();
+}
+
+void TextureAtlas::writePadded(const GLubyte* pixels, const GLsizei width, const GLsizei height, const int numChannels,
+    const GLsizei gutter, const GLsizei paddedWidth, const GLsizei paddedHeight, GLubyte* destination,
+    const std::size_t rowLength) {
+    for (GLsizei y = 0; y < paddedHeight; ++y) {
+        const GLsizei sourceY { std::clamp(y - gutter, 0, height - 1) };
+        GLubyte* out { destination + static_cast<std::size_t>(y) * rowLength * 4 };
+        for (GLsizei x = 0; x < paddedWidth; ++x) {
+            const GLsizei sourceX { std::clamp(x - gutter, 0, width - 1) };
+            const GLubyte* texel { pixels + (static_cast<std::size_t>(sourceY) * width + sourceX) * numChannels };
+            out[x * 4 + 0] = texel[0];
+            out[x * 4 + 1] = numChannels >= 3 ? texel[1] : texel[0];
+            out[x * 4 + 2] = numChannels >= 3 ? texel[2] : texel[0];
+            out[x * 4 + 3] = numChannels == 4 ? texel[3] : numChannels == 2 ? texel[1] : 255;
+        }
+    }
+}
+
+TextureAtlas::Region TextureAtlas::add(const GLubyte* pixels, const GLsizei width, const GLsizei height,
+    const int numChannels) {
+    if (!pixels || width <= 0 || height <= 0 || numChannels < 1 || numChannels > 4) {
+        return {};
+    }
+    const GLsizei gutter { gutterForLevels(m_mipLevels) };
+    const auto alignUp { [gutter](const GLsizei value) { return (value + gutter - 1) / gutter * gutter; } };
+    const GLsizei paddedWidth { alignUp(width + 2 * gutter) };
+    const GLsizei paddedHeight { alignUp(height + 2 * gutter) };
+    if (paddedWidth > m_pageSize || paddedHeight > m_pageSize) {
+        std::cout << "ERROR::TEXTURE_ATLAS::IMAGE_LARGER_THAN_PAGE: " << width << "x" << height << std::endl;
+        return {};
+    }
+
+    // Packing in grid units keeps every rectangle aligned to the gutter size.
+    SkylinePacker::Rect rect {};
+    std::size_t pageIndex {};
+    for (; pageIndex < m_pages.size(); ++pageIndex) {
+        rect = m_pages[pageIndex].packer.insert(paddedWidth / gutter, paddedHeight / gutter);
+        if (rect.height != 0) {
+            break;
+        }
+    }
+    if (pageIndex == m_pages.size()) {
+        rect = openPage().packer.insert(paddedWidth / gutter, paddedHeight / gutter);
+    }
+    const Page& page { m_pages[pageIndex] };
+    const GLint x { rect.x * gutter };
+    const GLint y { rect.y * gutter };
+
+    // The padded block's mips line up with the page's, so each level is uploaded on its own.
+    std::vector<GLubyte> padded(static_cast<std::size_t>(paddedWidth) * paddedHeight * 4);
+    writePadded(pixels, width, height, numChannels, gutter, paddedWidth, paddedHeight, padded.data(),
+        static_cast<std::size_t>(paddedWidth));
+    // Three and four channel images are colour, the rest data, as in ImageCache; padding to RGBA changes neither.
+    const MipChain mips { MipChain::build(padded.data(), paddedWidth, paddedHeight, 4, numChannels >= 3,
+        m_mipLevels) };
+    for (std::size_t i = 0; i < mips.getLevels().size(); ++i) {
+        const MipChain::Level& level { mips.getLevels()[i] };
+        page.texture->uploadRegion(static_cast<GLint>(i), x >> i, y >> i, level.width, level.height, 4,
+            mips.getData() + level.offset);
+    }
+
+    const auto size { static_cast<float>(m_pageSize) };
+    return { page.texture.get(),
+        glm::vec4(static_cast<float>(x + gutter) / size, static_cast<float>(y + gutter) / size,
+            static_cast<float>(x + gutter + width) / size, static_cast<float>(y + gutter + height) / size),
+        static_cast<int>(pageIndex) };
+}
+
+TextureAtlas::Region TextureAtlas::add(const std::string& path) {
+    // Only level 0 is used: the page's mips are built from the padded image so the gutters are in them too.
+    const MipChain mips { ImageCache::decode(path) };
+    if (mips.empty()) {
+        std::cout << "Failed to load texture: " << path << std::endl;
+        return {};
+    }
+    const MipChain::Level& top { mips.getLevels().front() };
+    return add(mips.getData() + top.offset, top.width, top.height, mips.getNumChannels());
+}
+
+std::unordered_map<std::string, glm::vec4> TextureAtlas::readManifest(const std::string& path) {
+    std::unordered_map<std::string, glm::vec4> regions;
+    std::ifstream file(path);
+    if (!file) {
+        std::cout << "ERROR::TEXTURE_ATLAS::FILE_NOT_SUCCESSFULLY_READ: " << path << std::endl;
+        return regions;
+    }
+    // One "name u0 v0 u1 v1" line per image.
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        glm::vec4 uvRect;
+        if (fields >> name >> uvRect.x >> uvRect.y >> uvRect.z >> uvRect.w) {
+            regions.emplace(std::move(name), uvRect);
+        }
+    }
+    return regions;
+}
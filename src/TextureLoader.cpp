@@ -0,0 +1,155 @@
+#include "TextureLoader.hpp"
+#include "GLStateCache.hpp"
+#include "ImageCache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+unsigned TextureLoader::defaultWorkerCount() {
+    const unsigned hardwareThreads { std::thread::hardware_concurrency() };
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+
+TextureLoader::TextureLoader(const unsigned workerCount, const GLsizeiptr stagingBytesPerFrame)
+    : m_staging(GL_PIXEL_UNPACK_BUFFER, stagingBytesPerFrame) {
+    for (unsigned i = 0; i < std::max(1u, workerCount); ++i) {
+        m_workers.emplace_back(&TextureLoader::workerLoop, this);
+    }
+}
+
+TextureLoader::~TextureLoader() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_requestAdded.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+std::shared_ptr<Texture> TextureLoader::load(const std::string& path, const GLenum texType) {
+    auto texture { std::make_shared<Texture>(texType) };
+    {
+        std::lock_guard lock(m_mutex);
+        m_requests.push_back({ texture, path });
+        ++m_pending;
+    }
+    m_requestAdded.notify_one();
+    return texture;
+}
+
+void TextureLoader::workerLoop() {
+    while (true) {
+        Request request;
+        {
+            std::unique_lock lock(m_mutex);
+            m_requestAdded.wait(lock, [this] { return m_stopping || !m_requests.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+
+        DecodedImage image { std::move(request.texture), std::move(request.path), {}, {} };
+        if (CompressedImage::isCompressedPath(image.path)) {
+            image.compressed = CompressedImage::load(image.path);
+        } else {
+            image.mips = ImageCache::decode(image.path);
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_decoded.push_back(std::move(image));
+        }
+        m_imageDecoded.notify_all();
+    }
+}
+
+bool TextureLoader::fitsStaging(const GLsizeiptr size) const {
+    return size + ALIGNMENT_SLACK <= m_staging.getFreeBytes();
+}
+
+void TextureLoader::uploadImage(DecodedImage& image) {
+    if (image.mips.empty() && image.compressed.empty()) {
+        std::cout << "Failed to load texture: " << image.path << std::endl;
+        return;
+    }
+
+    // Chains too big for the staging region go straight from client memory.
+    const GLsizeiptr size { image.getSize() };
+    const StreamBuffer::Allocation staging { fitsStaging(size) ? m_staging.allocate(size) : StreamBuffer::Allocation {} };
+    const void* base { image.getData() };
+    if (staging.data) {
+        // The driver copies out of the unpack buffer asynchronously instead of stalling on client memory.
+        // A chain from ImageCache is copied straight out of its mapped file.
+        std::memcpy(staging.data, image.getData(), static_cast<std::size_t>(size));
+        m_staging.flush();
+        m_staging.bind();
+        base = reinterpret_cast<const void*>(staging.offset);
+    }
+    if (image.compressed.empty()) {
+        image.texture->upload(image.mips, base);
+    } else if (!image.texture->upload(image.compressed, base)) {
+        std::cout << "Failed to load texture: " << image.path << std::endl;
+    }
+    if (staging.data) {
+        GLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+}
+
+void TextureLoader::update(const std::chrono::microseconds budget) {
+    const auto start { std::chrono::steady_clock::now() };
+    bool uploaded { false };
+
+    while (true) {
+        DecodedImage image;
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_decoded.empty()) {
+                break;
+            }
+            const DecodedImage& next { m_decoded.front() };
+            const GLsizeiptr size { next.getSize() };
+            // Leave the image for next frame once this frame's staging region cannot take it any more.
+            if (uploaded && size <= m_staging.getRegionSize() && !fitsStaging(size)) {
+                break;
+            }
+            image = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        uploadImage(image);
+        uploaded = true;
+        {
+            std::lock_guard lock(m_mutex);
+            --m_pending;
+        }
+
+        const auto elapsed { std::chrono::steady_clock::now() - start };
+        if (std::chrono::duration_cast<std::chrono::microseconds>(elapsed) >= budget) {
+            break;
+        }
+    }
+
+    if (uploaded) {
+        m_staging.endFrame();
+    }
+}
+
+void TextureLoader::waitAll() {
+    while (true) {
+        update(std::chrono::microseconds::max());
+        std::unique_lock lock(m_mutex);
+        if (m_pending == 0) {
+            return;
+        }
+        m_imageDecoded.wait(lock, [this] { return !m_decoded.empty(); });
+    }
+}
+
+std::size_t TextureLoader::getPendingCount() {
+    std::lock_guard lock(m_mutex);
+    return m_pending;
+}
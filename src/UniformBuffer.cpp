@@ -0,0 +1,90 @@
+#include "UniformBuffer.hpp"
+#include "FrameData.hpp"
+#include "GLStateCache.hpp"
+#include "GLCapabilities.hpp"
+#include "Hash.hpp"
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+    struct BlockInfo {
+        GLuint binding;
+        GLsizeiptr size;
+    };
+
+    // Keyed by the hashed block name.
+    std::unordered_map<std::uint64_t, BlockInfo>& blockRegistry() {
+        static std::unordered_map<std::uint64_t, BlockInfo> registry {
+            { fnv1a64("FrameData"), { FRAME_DATA_BINDING, sizeof(FrameData) } },
+        };
+        return registry;
+    }
+}
+
+UniformBuffer::UniformBuffer(const GLsizeiptr size, const GLuint binding) : m_size(size), m_binding(binding) {
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glCreateBuffers(1, &m_ID);
+        glNamedBufferStorage(m_ID, m_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    } else {
+        glGenBuffers(1, &m_ID);
+        GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, m_ID);
+        glBufferData(GL_UNIFORM_BUFFER, m_size, nullptr, GL_DYNAMIC_DRAW);
+    }
+    bind();
+}
+
+UniformBuffer::~UniformBuffer() {
+    glDeleteBuffers(1, &m_ID);
+    GLStateCache::onBufferDeleted(m_ID);
+}
+
+void UniformBuffer::update(const void* data, const GLsizeiptr size, const GLintptr offset) const {
+    if (offset < 0 || offset + size > m_size) {
+        std::cout << "ERROR::UNIFORM_BUFFER::OUT_OF_RANGE: " << size << " bytes at " << offset << " in a "
+                  << m_size << " byte buffer" << std::endl;
+        return;
+    }
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glNamedBufferSubData(m_ID, offset, size, data);
+    } else {
+        GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, m_ID);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+    }
+    bind();
+}
+
+void UniformBuffer::bind() const {
+    GLStateCache::bindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_ID);
+}
+
+void UniformBuffer::registerBlock(const std::string_view blockName, const GLuint binding, const GLsizeiptr size) {
+    blockRegistry()[fnv1a64(blockName)] = { binding, size };
+}
+
+void UniformBuffer::assignBlockBindings(const GLuint program) {
+    GLint blockCount {};
+    GLint maxNameLength {};
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength);
+
+    std::string name(static_cast<std::size_t>(maxNameLength), '\0');
+    for (GLint i = 0; i < blockCount; ++i) {
+        const auto blockIndex { static_cast<GLuint>(i) };
+        GLsizei length {};
+        glGetActiveUniformBlockName(program, blockIndex, maxNameLength, &length, name.data());
+        const std::string_view blockName(name.data(), static_cast<std::size_t>(length));
+
+        const auto it { blockRegistry().find(fnv1a64(blockName)) };
+        if (it == blockRegistry().end()) {
+            continue;
+        }
+        GLint dataSize {};
+        glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+        if (dataSize != it->second.size) {
+            std::cout << "ERROR::UNIFORM_BUFFER::BLOCK_SIZE_MISMATCH: " << blockName << " is " << dataSize
+                      << " bytes in program " << program << ", " << it->second.size << " in C++" << std::endl;
+        }
+        glUniformBlockBinding(program, blockIndex, it->second.binding);
+    }
+}
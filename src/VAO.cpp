@@ -3,27 +3,149 @@
 //
 
 #include "VAO.hpp"
+#include "GLStateCache.hpp"
+#include "GLCapabilities.hpp"
+#include <iostream>
 
 VAO::VAO() {
-    glGenVertexArrays(1, &m_ID);
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glCreateVertexArrays(1, &m_ID);
+    } else {
+        glGenVertexArrays(1, &m_ID);
+    }
 }
 
 VAO::~VAO() {
     glDeleteVertexArrays(1, &m_ID);
+    GLStateCache::onVertexArrayDeleted(m_ID);
 }
 
 void VAO::bind() const {
-    glBindVertexArray(m_ID);
+    GLStateCache::bindVertexArray(m_ID);
 }
 
 void VAO::unbind() {
-    glBindVertexArray(0);
+    GLStateCache::bindVertexArray(0);
 }
 
-void VAO::linkAttrib(const VBO &VBO, const GLuint layout, const GLint numComponents, const GLenum type,
-    const GLsizei stride, const void *offset) {
-    VBO.bind();
-    glVertexAttribPointer(layout, numComponents, type, GL_FALSE, stride, offset);
+GLsizei VAO::attribSize(const GLint numComponents, const GLenum type) {
+    switch (type) {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:
+            return numComponents;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:
+            return 2 * numComponents;
+        case GL_DOUBLE:
+            return 8 * numComponents;
+        case GL_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_10F_11F_11F_REV:
+            return 4;
+        default:
+            return 4 * numComponents;
+    }
+}
+
+void VAO::linkBuffer(const GLuint buffer, const GLuint layout, const GLint numComponents, const GLenum type,
+    const GLsizei stride, const void *offset, const GLuint divisor, const AttribMode mode) const {
+    const bool integer { mode == AttribMode::Integer };
+    if (integer && (type == GL_FLOAT || type == GL_HALF_FLOAT || type == GL_DOUBLE)) {
+        std::cout << "ERROR::VAO::INTEGER_ATTRIB_NEEDS_INTEGER_TYPE: layout " << layout << std::endl;
+        return;
+    }
+    const auto normalized { static_cast<GLboolean>(mode == AttribMode::Normalized ? GL_TRUE : GL_FALSE) };
+
+    if (GLCapabilities::hasDirectStateAccess()) {
+        // A binding point has no "tightly packed" default, so stride 0 is spelled out.
+        const GLsizei bindingStride { stride != 0 ? stride : attribSize(numComponents, type) };
+        glVertexArrayVertexBuffer(m_ID, layout, buffer, reinterpret_cast<GLintptr>(offset), bindingStride);
+        if (integer) {
+            glVertexArrayAttribIFormat(m_ID, layout, numComponents, type, 0);
+        } else {
+            glVertexArrayAttribFormat(m_ID, layout, numComponents, type, normalized, 0);
+        }
+        glVertexArrayAttribBinding(m_ID, layout, layout);
+        glVertexArrayBindingDivisor(m_ID, layout, divisor);
+        glEnableVertexArrayAttrib(m_ID, layout);
+        return;
+    }
+
+    // The attribute keeps its own reference to the buffer; GL_ARRAY_BUFFER can stay bound for the next one.
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (integer) {
+        glVertexAttribIPointer(layout, numComponents, type, stride, offset);
+    } else {
+        glVertexAttribPointer(layout, numComponents, type, normalized, stride, offset);
+    }
     glEnableVertexAttribArray(layout);
-    VBO.unbind();
+    glVertexAttribDivisor(layout, divisor);
+}
+
+void VAO::linkMat4(const GLuint buffer, const GLuint layout, const GLsizei stride, const void *offset,
+    const GLuint divisor) const {
+    const auto* column { static_cast<const GLubyte*>(offset) };
+    for (GLuint i = 0; i < 4; ++i) {
+        linkBuffer(buffer, layout + i, 4, GL_FLOAT, stride, column + i * 4 * sizeof(GLfloat), divisor,
+            AttribMode::Float);
+    }
+}
+
+void VAO::linkAttrib(const VBO &VBO, const GLuint layout, const GLint numComponents, const GLenum type,
+    const GLsizei stride, const void *offset, const AttribMode mode) {
+    linkBuffer(VBO.getID(), layout, numComponents, type, stride, offset, 0, mode);
+}
+
+void VAO::linkAttrib(const StreamBuffer &buffer, const GLuint layout, const GLint numComponents, const GLenum type,
+    const GLsizei stride, const void *offset, const AttribMode mode) {
+    linkBuffer(buffer.getID(), layout, numComponents, type, stride, offset, 0, mode);
+}
+
+void VAO::linkInstanceAttrib(const VBO &VBO, const GLuint layout, const GLint numComponents, const GLenum type,
+    const GLsizei stride, const void *offset, const GLuint divisor, const AttribMode mode) {
+    linkBuffer(VBO.getID(), layout, numComponents, type, stride, offset, divisor, mode);
+}
+
+void VAO::linkInstanceAttrib(const StreamBuffer &buffer, const GLuint layout, const GLint numComponents,
+    const GLenum type, const GLsizei stride, const void *offset, const GLuint divisor, const AttribMode mode) {
+    linkBuffer(buffer.getID(), layout, numComponents, type, stride, offset, divisor, mode);
+}
+
+void VAO::linkInstanceMat4(const VBO &VBO, const GLuint layout, const GLsizei stride, const void *offset,
+    const GLuint divisor) {
+    linkMat4(VBO.getID(), layout, stride, offset, divisor);
+}
+
+void VAO::linkInstanceMat4(const StreamBuffer &buffer, const GLuint layout, const GLsizei stride,
+    const void *offset, const GLuint divisor) {
+    linkMat4(buffer.getID(), layout, stride, offset, divisor);
+}
+
+void VAO::setDivisor(const GLuint layout, const GLuint divisor) {
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glVertexArrayBindingDivisor(m_ID, layout, divisor);
+    } else {
+        glVertexAttribDivisor(layout, divisor);
+    }
+}
+
+void VAO::setElementBuffer(const EBO &EBO) const {
+    if (GLCapabilities::hasDirectStateAccess()) {
+        glVertexArrayElementBuffer(m_ID, EBO.getID());
+        GLStateCache::onElementBufferChanged(m_ID, EBO.getID());
+    } else {
+        bind();
+        EBO.bind();
+    }
+}
+
+void VAO::drawElementsInstanced(const GLenum mode, const GLsizei count, const GLenum indexType,
+    const GLsizei instanceCount, const GLuint baseInstance) const {
+    bind();
+    if (baseInstance != 0) {
+        glDrawElementsInstancedBaseInstance(mode, count, indexType, nullptr, instanceCount, baseInstance);
+    } else {
+        glDrawElementsInstanced(mode, count, indexType, nullptr, instanceCount);
+    }
 }
@@ -3,8 +3,16 @@
 //
 
 #include "VBO.hpp"
+#include "GLStateCache.hpp"
+#include "GLCapabilities.hpp"
 
-VBO::VBO(const GLfloat *vertices, const GLsizeiptr size) {
+VBO::VBO(const void *vertices, const GLsizeiptr size) {
+    if (GLCapabilities::hasDirectStateAccess()) {
+        // Immutable storage filled once, without touching any binding.
+        glCreateBuffers(1, &m_ID);
+        glNamedBufferStorage(m_ID, size, vertices, 0);
+        return;
+    }
     glGenBuffers(1, &m_ID);
     bind();
     glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
@@ -12,12 +20,13 @@ VBO::VBO(const GLfloat *vertices, const GLsizeiptr size) {
 
 VBO::~VBO() {
     glDeleteBuffers(1, &m_ID);
+    GLStateCache::onBufferDeleted(m_ID);
 }
 
 void VBO::bind() const {
-    glBindBuffer(GL_ARRAY_BUFFER, m_ID);
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, m_ID);
 }
 
 void VBO::unbind() {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -0,0 +1,126 @@
+#include "VertexPacking.hpp"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define COREGL_HAS_F16C
+#endif
+
+namespace {
+    std::int32_t toSnorm(const float value, const float scale) {
+        const float clamped { value > -1.0f ? (value < 1.0f ? value : 1.0f) : -1.0f };
+        return static_cast<std::int32_t>(std::lround(clamped * scale));
+    }
+
+    // Converts count vertices one component at a time; Convert maps a float to the stored type.
+    template <typename Stored, typename Convert>
+    void pack(const float* source, const std::size_t sourceStride, const std::size_t components,
+        const std::size_t count, void* destination, const std::size_t destinationStride, Convert convert) {
+        auto* out { static_cast<GLubyte*>(destination) };
+        if (sourceStride == components && destinationStride == components * sizeof(Stored)) {
+            auto* packed { reinterpret_cast<Stored*>(out) };
+            const std::size_t total { components * count };
+            for (std::size_t i = 0; i < total; ++i) {
+                packed[i] = convert(source[i]);
+            }
+            return;
+        }
+        for (std::size_t v = 0; v < count; ++v) {
+            const float* in { source + v * sourceStride };
+            GLubyte* vertex { out + v * destinationStride };
+            for (std::size_t c = 0; c < components; ++c) {
+                const Stored value { convert(in[c]) };
+                std::memcpy(vertex + c * sizeof(Stored), &value, sizeof(Stored));
+            }
+        }
+    }
+}
+
+GLhalf VertexPacking::toHalf(const float value) {
+    constexpr std::uint32_t FLOAT_INFINITY { 255u << 23 };
+    constexpr std::uint32_t HALF_OVERFLOW { (127u + 16u) << 23 };     // 65536.0f
+    constexpr std::uint32_t HALF_SUBNORMAL { 113u << 23 };            // 2^-14, the smallest normal half.
+    constexpr std::uint32_t DENORMAL_MAGIC { ((127u - 15u) + (23u - 10u) + 1u) << 23 };
+
+    std::uint32_t bits { std::bit_cast<std::uint32_t>(value) };
+    const std::uint32_t sign { bits & 0x80000000u };
+    bits ^= sign;
+
+    std::uint32_t half {};
+    if (bits >= HALF_OVERFLOW) {
+        // NaNs keep the top of their payload and come out quiet, as F16C converts them.
+        half = bits > FLOAT_INFINITY ? 0x7e00u | ((bits >> 13) & 0x3ffu) : 0x7c00u;
+    } else if (bits < HALF_SUBNORMAL) {
+        // Adding the magic number lets the FPU do the rounding into the subnormal range.
+        const float shifted { std::bit_cast<float>(bits) + std::bit_cast<float>(DENORMAL_MAGIC) };
+        half = std::bit_cast<std::uint32_t>(shifted) - DENORMAL_MAGIC;
+    } else {
+        const std::uint32_t mantissaOdd { (bits >> 13) & 1u };
+        bits += (static_cast<std::uint32_t>(15 - 127) << 23) + 0xfffu + mantissaOdd;
+        half = bits >> 13;
+    }
+    return static_cast<GLhalf>(half | (sign >> 16));
+}
+
+float VertexPacking::fromHalf(const GLhalf value) {
+    const std::uint32_t sign { static_cast<std::uint32_t>(value & 0x8000u) << 16 };
+    const std::uint32_t exponent { (value >> 10) & 0x1fu };
+    const std::uint32_t mantissa { value & 0x3ffu };
+    if (exponent == 0) {
+        const float magnitude { std::ldexp(static_cast<float>(mantissa), -24) };
+        return sign ? -magnitude : magnitude;
+    }
+    if (exponent == 31) {
+        return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+}
+
+GLubyte VertexPacking::toUnorm8(const float value) {
+    const float clamped { value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f };
+    return static_cast<GLubyte>(clamped * 255.0f + 0.5f);
+}
+
+GLuint VertexPacking::toSnorm1010102(const glm::vec3 value, const float w) {
+    const auto x { static_cast<std::uint32_t>(toSnorm(value.x, 511.0f)) & 0x3ffu };
+    const auto y { static_cast<std::uint32_t>(toSnorm(value.y, 511.0f)) & 0x3ffu };
+    const auto z { static_cast<std::uint32_t>(toSnorm(value.z, 511.0f)) & 0x3ffu };
+    const auto a { static_cast<std::uint32_t>(toSnorm(w, 1.0f)) & 0x3u };
+    return x | (y << 10) | (z << 20) | (a << 30);
+}
+
+void VertexPacking::packHalf(const float* source, const std::size_t sourceStride, const std::size_t components,
+    const std::size_t count, void* destination, const std::size_t destinationStride) {
+#ifdef COREGL_HAS_F16C
+    if (sourceStride == components && destinationStride == components * sizeof(GLhalf)) {
+        auto* out { static_cast<GLubyte*>(destination) };
+        const std::size_t total { components * count };
+        std::size_t i {};
+        for (; i + 8 <= total; i += 8) {
+            const __m128i halves { _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT) };
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * sizeof(GLhalf)), halves);
+        }
+        pack<GLhalf>(source + i, 1, 1, total - i, out + i * sizeof(GLhalf), sizeof(GLhalf), toHalf);
+        return;
+    }
+#endif
+    pack<GLhalf>(source, sourceStride, components, count, destination, destinationStride, toHalf);
+}
+
+void VertexPacking::packUnorm8(const float* source, const std::size_t sourceStride, const std::size_t components,
+    const std::size_t count, void* destination, const std::size_t destinationStride) {
+    pack<GLubyte>(source, sourceStride, components, count, destination, destinationStride, toUnorm8);
+}
+
+void VertexPacking::packSnorm1010102(const float* source, const std::size_t sourceStride, const std::size_t count,
+    void* destination, const std::size_t destinationStride) {
+    auto* out { static_cast<GLubyte*>(destination) };
+    for (std::size_t v = 0; v < count; ++v) {
+        const float* in { source + v * sourceStride };
+        const GLuint packed { toSnorm1010102({ in[0], in[1], in[2] }) };
+        std::memcpy(out + v * destinationStride, &packed, sizeof(packed));
+    }
+}
@@ -1,6 +1,17 @@
 #include "WindowManager.hpp"
+#include "GLCapabilities.hpp"
+#include "GLStateCache.hpp"
+#include <cstdlib>
 
-WindowManager::WindowManager() : m_window(nullptr) {}
+bool WindowManager::s_headless { false };
+int WindowManager::s_contextMajor { 3 };
+int WindowManager::s_contextMinor { 3 };
+
+WindowManager::WindowManager() : m_window(nullptr) {
+    if (const char* frames { std::getenv("COREGL_HEADLESS_FRAMES") }) {
+        m_frameLimit = std::atoll(frames);
+    }
+}
 
 WindowManager::~WindowManager() {
     if (m_window) {
@@ -13,7 +24,7 @@ void WindowManager::Log(const char *message){
 }
 
 void WindowManager::framebuffer_size_callback(GLFWwindow *window, const int width, const int height) {
-    glViewport(0, 0, width, height);
+    GLStateCache::setViewport(0, 0, width, height);
     // Recovers our class from the window's user pointer and updates the width and height values.
     if (WindowManager* instance { static_cast<WindowManager*>(glfwGetWindowUserPointer(window)) }) {
         instance->m_width = width;
@@ -21,7 +32,25 @@ void WindowManager::framebuffer_size_callback(GLFWwindow *window, const int widt
     }
 }
 
+void WindowManager::enableHeadless() {
+    s_headless = true;
+}
+
+bool WindowManager::isHeadless() {
+    return s_headless;
+}
+
 void WindowManager::initializeGLFW(const int versionMajor, const int versionMinor) {
+    s_contextMajor = versionMajor;
+    s_contextMinor = versionMinor;
+
+    if (const char* headless { std::getenv("COREGL_HEADLESS") }; headless && *headless && std::string(headless) != "0") {
+        s_headless = true;
+    }
+    if (s_headless) {
+        // The null platform needs no display server but still gives us windows, input state and timers.
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
 
     if (!glfwInit()) {
         Log("Failed to initialize GLFW. Bailing out!");
@@ -46,6 +75,9 @@ void WindowManager::initializeGLFW(const int versionMajor, const int versionMino
 void WindowManager::initializeWindow(const int width, const int height, const char* name) {
     m_width = width;
     m_height = height;
+    if (s_headless) {
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API); // The context comes from EGL instead.
+    }
     m_window = glfwCreateWindow(
         m_width,
         m_height,
@@ -61,50 +93,114 @@ void WindowManager::initializeWindow(const int width, const int height, const ch
     }
 
     GLFWmonitor* monitor = glfwGetPrimaryMonitor();
-    const GLFWvidmode* mode = glfwGetVideoMode(monitor);
+    const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
 
-    const std::string windowMessage = "Window created: \"" + std::string(name) +
-                                "\" " + std::to_string(width) + "x" +
-                                std::to_string(height) + "@" + std::to_string(mode->refreshRate) + "Hz";
+    const std::string windowMessage = std::string(s_headless ? "Headless window" : "Window") + " created: \"" +
+                                std::string(name) + "\" " + std::to_string(width) + "x" +
+                                std::to_string(height) + "@" + std::to_string(mode ? mode->refreshRate : 0) + "Hz";
     Log(windowMessage.c_str());
 
     glfwSetWindowUserPointer(m_window, this); // Connects the window to this class' object.
-    glfwMakeContextCurrent(m_window);
-    glfwSetFramebufferSizeCallback(m_window, framebuffer_size_callback);
-    toggleVsync(true);
 
-    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
-        Log("Failed to initialize glad. Bailing out!");
-        glfwTerminate();
-        std::exit(EXIT_FAILURE);
-    };
+    if (s_headless) {
+        initializeHeadlessContext();
+    } else {
+        glfwMakeContextCurrent(m_window);
+        glfwSetFramebufferSizeCallback(m_window, framebuffer_size_callback);
+        toggleVsync(true);
+
+        if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
+            Log("Failed to initialize glad. Bailing out!");
+            glfwTerminate();
+            std::exit(EXIT_FAILURE);
+        };
+        GLCapabilities::load(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
+        GLStateCache::invalidate();
+    }
 
     const std::string glInfoMessage = "OpenGL version: " +
                 std::string(reinterpret_cast<const char*>(glGetString(GL_VERSION))) + " | GLSL " +
                 std::string(reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION)));
     Log(glInfoMessage.c_str());
 
-    glViewport(0, 0, m_width, m_height);
+    GLStateCache::setViewport(0, 0, m_width, m_height);
+
+    m_benchmark = FrameBenchmark::createFromEnvironment(name);
+    if (m_benchmark) {
+        toggleVsync(false);
+        if (m_frameLimit == 0) {
+            m_frameLimit = m_benchmark->getFrameBudget();
+        }
+    }
+}
+
+void WindowManager::initializeHeadlessContext() {
+    m_headlessContext = std::make_unique<HeadlessContext>();
+    if (!m_headlessContext->create(m_width, m_height, s_contextMajor, s_contextMinor)) {
+        Log("Failed to create a headless OpenGL context. Bailing out!");
+        glfwTerminate();
+        std::exit(EXIT_FAILURE);
+    }
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(HeadlessContext::getProcAddress))) {
+        Log("Failed to initialize glad. Bailing out!");
+        glfwTerminate();
+        std::exit(EXIT_FAILURE);
+    }
+    GLCapabilities::load(reinterpret_cast<GLADloadproc>(HeadlessContext::getProcAddress));
+    GLStateCache::invalidate();
+
+    if (!m_headlessContext->createFramebuffer()) {
+        Log("Failed to create the headless framebuffer. Bailing out!");
+        glfwTerminate();
+        std::exit(EXIT_FAILURE);
+    }
 }
 
 void WindowManager::beginDrawing()
 {
-    m_currentTime = static_cast<float>(glfwGetTime());
-    m_deltaTime = m_currentTime - m_lastTime;
+    m_scheduler.beginFrame();
+    m_deltaTime = static_cast<float>(m_scheduler.getDeltaSeconds());
 }
 
 void WindowManager::endDrawing()
 {
-    glfwSwapBuffers(m_window);
-    glfwPollEvents();
-    m_lastTime = m_currentTime;
+    if (m_benchmark) {
+        m_benchmark->endFrame();
+    }
+    if (m_headlessContext) {
+        glFlush(); // Nothing to present; just keep the driver queue from growing without bound.
+    } else {
+        glfwSwapBuffers(m_window);
+    }
+    if (!m_benchmark) {
+        m_scheduler.waitForNextFrame(); // Benchmarks run with vsync off so frames are unthrottled.
+    }
+    glfwPollEvents(); // After the wait, so the next frame sees the freshest input.
+    ++m_frameCount;
+
+    if (m_benchmark) {
+        m_benchmark->beginFrame();
+        if (m_frameCount >= m_benchmark->getFrameBudget()) {
+            m_benchmark->writeReport(); // Written while the context is still guaranteed to be alive.
+        }
+    }
 }
 
-void WindowManager::destroyWindow() const {
+void WindowManager::destroyWindow() {
+    if (m_benchmark) {
+        m_benchmark->writeReport();
+        m_benchmark.reset();
+    }
+    m_headlessContext.reset();
     glfwDestroyWindow(m_window);
+    m_window = nullptr;
 }
 
 bool WindowManager::windowShouldClose() const{
+    if (m_frameLimit > 0 && m_frameCount >= m_frameLimit) {
+        return true;
+    }
     return glfwWindowShouldClose(m_window);
 }
 
@@ -114,5 +210,31 @@ GLFWwindow* WindowManager::getWindow() const {
 
 void WindowManager::toggleVsync(bool vsyncEnabled)
 {
+    if (m_headlessContext) {
+        return; // There is no swap chain to sync with.
+    }
+    if (m_benchmark) {
+        vsyncEnabled = false; // Benchmarks always measure unthrottled frames.
+    }
     glfwSwapInterval(vsyncEnabled ? 1 : 0);
+}
+
+void WindowManager::setFrameLimit(const long long frames) {
+    m_frameLimit = frames;
+}
+
+GLuint WindowManager::getFramebuffer() const {
+    return m_headlessContext ? m_headlessContext->getFramebuffer() : 0;
+}
+
+void WindowManager::readPixels(std::vector<GLubyte>& pixels) const {
+    if (m_headlessContext) {
+        m_headlessContext->readPixels(pixels);
+        return;
+    }
+    pixels.resize(static_cast<std::size_t>(m_width) * m_height * 4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+// Offline atlas builder: packs images into one page with gutters like TextureAtlas's at run time, widened
+// to a whole 4x4 block at the smallest level, then writes the page as a BC1/BC3 KTX2 file plus a manifest of
+// UV rectangles beside it.
+//
+//     atlas_pack [--size 2048] [--levels 3] output.ktx2 image...
+//
+// output.atlas gets one "name u0 v0 u1 v1" line per image, name being the file name without extension;
+// TextureAtlas::readManifest reads it back. Images are packed tallest first, which packs tighter than
+// the arrival order the runtime allocator has to live with.
+
+#include "BlockEncoder.hpp"
+#include "SkylinePacker.hpp"
+#include "TextureAtlas.hpp"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Image {
+        std::string name;
+        GLubyte* pixels {};
+        int width {};
+        int height {};
+        int numChannels {};
+        SkylinePacker::Rect rect {};
+    };
+}
+
+int main(const int argc, char** argv) {
+    GLsizei pageSize { 2048 };
+    GLsizei mipLevels { 3 };
+    std::string output;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument { argv[i] };
+        if (argument == "--size" && i + 1 < argc) {
+            pageSize = std::stoi(argv[++i]);
+        } else if (argument == "--levels" && i + 1 < argc) {
+            mipLevels = std::max(1, std::stoi(argv[++i]));
+        } else if (output.empty()) {
+            output = argument;
+        } else {
+            inputs.push_back(argument);
+        }
+    }
+    if (output.empty() || inputs.empty()) {
+        std::cout << "usage: atlas_pack [--size 2048] [--levels 3] output.ktx2 image..." << std::endl;
+        return 1;
+    }
+
+    stbi_set_flip_vertically_on_load(true); // Same orientation as Texture's stb_image path.
+    std::vector<Image> images;
+    for (const std::string& input : inputs) {
+        Image image { std::filesystem::path(input).stem().string() };
+        image.pixels = stbi_load(input.c_str(), &image.width, &image.height, &image.numChannels, STBI_default);
+        if (!image.pixels) {
+            std::cout << "Failed to load texture: " << input << std::endl;
+            return 1;
+        }
+        images.push_back(std::move(image));
+    }
+
+    // Compression works on 4x4 blocks at every level, so cells start and end on block boundaries down to the
+    // smallest level and the gutter covers a whole block there: no block mixes two images' endpoints.
+    const GLsizei gutter { 4 * TextureAtlas::gutterForLevels(mipLevels) };
+    const auto alignUp { [gutter](const int value) { return (value + gutter - 1) / gutter * gutter; } };
+    std::vector<Image*> order;
+    for (Image& image : images) {
+        order.push_back(&image);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const Image* a, const Image* b) { return a->height > b->height; });
+
+    // Packed in grid units, like TextureAtlas::add.
+    SkylinePacker packer(pageSize / gutter, pageSize / gutter);
+    for (Image* image : order) {
+        image->rect = packer.insert(alignUp(image->width + 2 * gutter) / gutter,
+            alignUp(image->height + 2 * gutter) / gutter);
+        if (image->rect.height == 0) {
+            std::cout << "ERROR::ATLAS_PACK::PAGE_FULL: " << image->name << " does not fit a " << pageSize << " page"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<GLubyte> page(static_cast<std::size_t>(pageSize) * pageSize * 4);
+    bool opaque { true };
+    for (const Image& image : images) {
+        const SkylinePacker::Rect& rect { image.rect };
+        GLubyte* origin { page.data() + (static_cast<std::size_t>(rect.y * gutter) * pageSize + rect.x * gutter) * 4 };
+        TextureAtlas::writePadded(image.pixels, image.width, image.height, image.numChannels, gutter,
+            rect.width * gutter, rect.height * gutter, origin, static_cast<std::size_t>(pageSize));
+        opaque = opaque && image.numChannels != 2 && image.numChannels != 4;
+        stbi_image_free(image.pixels);
+    }
+
+    const MipChain mips { MipChain::build(page.data(), pageSize, pageSize, 4, true, mipLevels) };
+    const BlockEncoder::Format format { opaque ? BlockEncoder::Format::BC1 : BlockEncoder::Format::BC3 };
+    if (!BlockEncoder::compress(mips, format, false).writeKTX2(output)) {
+        return 1;
+    }
+
+    std::filesystem::path manifestPath { output };
+    manifestPath.replace_extension(".atlas");
+    std::ofstream manifest(manifestPath);
+    const auto size { static_cast<float>(pageSize) };
+    for (const Image& image : images) {
+        const float x { static_cast<float>(image.rect.x * gutter + gutter) };
+        const float y { static_cast<float>(image.rect.y * gutter + gutter) };
+        manifest << image.name << ' ' << x / size << ' ' << y / size << ' ' << (x + image.width) / size << ' '
+                 << (y + image.height) / size << '\n';
+    }
+    if (!manifest) {
+        std::cout << "ERROR::ATLAS_PACK::WRITE_FAILED: " << manifestPath.string() << std::endl;
+        return 1;
+    }
+    std::cout << images.size() << " images -> " << output << " (" << BlockEncoder::formatName(format) << ", "
+              << static_cast<int>(packer.getOccupancy() * 100.0f) << "% of the page used)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,253 @@
+#include "BlockEncoder.hpp"
+#include "GLCapabilities.hpp" // S3TC enums
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+    using Colour = std::array<float, 3>;
+
+    std::uint16_t packRGB565(const Colour& colour) {
+        const auto quantize { [](const float value, const int maximum) {
+            return static_cast<std::uint16_t>(std::lround(std::clamp(value, 0.0f, 255.0f) * maximum / 255.0f));
+        } };
+        return static_cast<std::uint16_t>(quantize(colour[0], 31) << 11 | quantize(colour[1], 63) << 5
+            | quantize(colour[2], 31));
+    }
+
+    Colour unpackRGB565(const std::uint16_t packed) {
+        const int r { packed >> 11 & 31 };
+        const int g { packed >> 5 & 63 };
+        const int b { packed & 31 };
+        return { static_cast<float>(r << 3 | r >> 2), static_cast<float>(g << 2 | g >> 4),
+            static_cast<float>(b << 3 | b >> 2) };
+    }
+
+    float distanceSquared(const Colour& a, const GLubyte* b) {
+        float sum {};
+        for (int c = 0; c < 3; ++c) {
+            const float difference { a[c] - b[c] };
+            sum += difference * difference;
+        }
+        return sum;
+    }
+
+    // Gathers the 4x4 block at (blockX, blockY) as RGBA, repeating the last row/column past the edge.
+    void gatherBlock(const GLubyte* level, const MipChain::Level& size, const int numChannels, const int blockX,
+        const int blockY, GLubyte (&block)[16][4]) {
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) {
+                const int sourceX { std::min(blockX * 4 + x, size.width - 1) };
+                const int sourceY { std::min(blockY * 4 + y, size.height - 1) };
+                const GLubyte* texel { level + (static_cast<std::size_t>(sourceY) * size.width + sourceX) * numChannels };
+                GLubyte* out { block[y * 4 + x] };
+                out[0] = texel[0];
+                out[1] = numChannels >= 2 ? texel[1] : texel[0];
+                out[2] = numChannels >= 3 ? texel[2] : texel[0];
+                out[3] = numChannels == 4 ? texel[3] : 255;
+            }
+        }
+    }
+
+    void writeLittleEndian(GLubyte* out, const std::uint64_t value, const int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out[i] = static_cast<GLubyte>(value >> (8 * i));
+        }
+    }
+}
+
+void BlockEncoder::encodeBC1(const GLubyte (&block)[16][4], GLubyte* out) {
+    Colour mean {};
+    for (const auto& texel : block) {
+        for (int c = 0; c < 3; ++c) {
+            mean[c] += texel[c] / 16.0f;
+        }
+    }
+    float covariance[6] {}; // xx, xy, xz, yy, yz, zz
+    for (const auto& texel : block) {
+        const float x { texel[0] - mean[0] };
+        const float y { texel[1] - mean[1] };
+        const float z { texel[2] - mean[2] };
+        covariance[0] += x * x;
+        covariance[1] += x * y;
+        covariance[2] += x * z;
+        covariance[3] += y * y;
+        covariance[4] += y * z;
+        covariance[5] += z * z;
+    }
+
+    // Power iteration for the principal axis. Starting from the texel farthest from the mean keeps the
+    // start away from perpendicular to the answer; a few steps settle for 16 points.
+    Colour axis { 1.0f, 1.0f, 1.0f };
+    float farthest {};
+    for (const auto& texel : block) {
+        const float distance { distanceSquared(mean, texel) };
+        if (distance > farthest) {
+            farthest = distance;
+            axis = { texel[0] - mean[0], texel[1] - mean[1], texel[2] - mean[2] };
+        }
+    }
+    for (int i = 0; i < 8; ++i) {
+        const Colour next {
+            covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+            covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+            covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2],
+        };
+        const float length { std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]) };
+        if (length < 1e-6f) {
+            break;
+        }
+        axis = { next[0] / length, next[1] / length, next[2] / length };
+    }
+
+    float lowest { 0.0f };
+    float highest { 0.0f };
+    for (const auto& texel : block) {
+        const float t { (texel[0] - mean[0]) * axis[0] + (texel[1] - mean[1]) * axis[1] + (texel[2] - mean[2]) * axis[2] };
+        lowest = std::min(lowest, t);
+        highest = std::max(highest, t);
+    }
+    std::uint16_t colour0 { packRGB565({ mean[0] + axis[0] * highest, mean[1] + axis[1] * highest,
+        mean[2] + axis[2] * highest }) };
+    std::uint16_t colour1 { packRGB565({ mean[0] + axis[0] * lowest, mean[1] + axis[1] * lowest,
+        mean[2] + axis[2] * lowest }) };
+    // colour0 > colour1 selects four-colour mode.
+    if (colour0 < colour1) {
+        std::swap(colour0, colour1);
+    }
+
+    std::uint32_t indices {};
+    if (colour0 != colour1) {
+        const Colour end0 { unpackRGB565(colour0) };
+        const Colour end1 { unpackRGB565(colour1) };
+        std::array<Colour, 4> palette { end0, end1 };
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2.0f * end0[c] + end1[c]) / 3.0f;
+            palette[3][c] = (end0[c] + 2.0f * end1[c]) / 3.0f;
+        }
+        for (int i = 0; i < 16; ++i) {
+            std::uint32_t best {};
+            float bestDistance { distanceSquared(palette[0], block[i]) };
+            for (std::uint32_t p = 1; p < 4; ++p) {
+                const float distance { distanceSquared(palette[p], block[i]) };
+                if (distance < bestDistance) {
+                    best = p;
+                    bestDistance = distance;
+                }
+            }
+            indices |= best << (2 * i);
+        }
+    }
+    writeLittleEndian(out, colour0, 2);
+    writeLittleEndian(out + 2, colour1, 2);
+    writeLittleEndian(out + 4, indices, 4);
+}
+
+void BlockEncoder::encodeBC4(const GLubyte (&block)[16][4], const int channel, GLubyte* out) {
+    GLubyte lowest { 255 };
+    GLubyte highest { 0 };
+    for (const auto& texel : block) {
+        lowest = std::min(lowest, texel[channel]);
+        highest = std::max(highest, texel[channel]);
+    }
+
+    // highest > lowest selects the eight-value mode: both ends plus six steps between them.
+    std::uint64_t indices {};
+    if (highest != lowest) {
+        std::array<float, 8> palette { static_cast<float>(highest), static_cast<float>(lowest) };
+        for (int i = 1; i < 7; ++i) {
+            palette[i + 1] = ((7 - i) * palette[0] + i * palette[1]) / 7.0f;
+        }
+        for (int i = 0; i < 16; ++i) {
+            std::uint64_t best {};
+            float bestDistance { std::abs(palette[0] - block[i][channel]) };
+            for (std::uint64_t p = 1; p < 8; ++p) {
+                const float distance { std::abs(palette[p] - block[i][channel]) };
+                if (distance < bestDistance) {
+                    best = p;
+                    bestDistance = distance;
+                }
+            }
+            indices |= best << (3 * i);
+        }
+    }
+    out[0] = highest;
+    out[1] = lowest;
+    writeLittleEndian(out + 2, indices, 6);
+}
+
+void BlockEncoder::encodeBC3(const GLubyte (&block)[16][4], GLubyte* out) {
+    encodeBC4(block, 3, out);
+    encodeBC1(block, out + 8);
+}
+
+void BlockEncoder::encodeBC5(const GLubyte (&block)[16][4], GLubyte* out) {
+    encodeBC4(block, 0, out);
+    encodeBC4(block, 1, out + 8);
+}
+
+GLenum BlockEncoder::internalFormat(const Format format, const bool srgb) {
+    switch (format) {
+        case Format::BC1:
+            return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case Format::BC3:
+            return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case Format::BC4:
+            return GL_COMPRESSED_RED_RGTC1;
+        default:
+            return GL_COMPRESSED_RG_RGTC2;
+    }
+}
+
+const char* BlockEncoder::formatName(const Format format) {
+    switch (format) {
+        case Format::BC1:
+            return "BC1";
+        case Format::BC3:
+            return "BC3";
+        case Format::BC4:
+            return "BC4";
+        default:
+            return "BC5";
+    }
+}
+
+CompressedImage BlockEncoder::compress(const MipChain& mips, const Format format, const bool srgb) {
+    const GLenum glFormat { internalFormat(format, srgb) };
+    const auto blockBytes { static_cast<std::size_t>(CompressedImage::blockBytes(glFormat)) };
+    std::vector<GLubyte> data;
+    std::vector<CompressedImage::Level> levels;
+    for (const MipChain::Level& level : mips.getLevels()) {
+        const int blocksWide { (level.width + 3) / 4 };
+        const int blocksHigh { (level.height + 3) / 4 };
+        const std::size_t offset { data.size() };
+        data.resize(offset + static_cast<std::size_t>(blocksWide) * blocksHigh * blockBytes);
+        GLubyte* out { data.data() + offset };
+
+        GLubyte block[16][4];
+        for (int blockY = 0; blockY < blocksHigh; ++blockY) {
+            for (int blockX = 0; blockX < blocksWide; ++blockX) {
+                gatherBlock(mips.getData() + level.offset, level, mips.getNumChannels(), blockX, blockY, block);
+                switch (format) {
+                    case Format::BC1:
+                        encodeBC1(block, out);
+                        break;
+                    case Format::BC3:
+                        encodeBC3(block, out);
+                        break;
+                    case Format::BC4:
+                        encodeBC4(block, 0, out);
+                        break;
+                    default:
+                        encodeBC5(block, out);
+                        break;
+                }
+                out += blockBytes;
+            }
+        }
+        levels.push_back({ level.width, level.height, offset, data.size() - offset });
+    }
+    return { glFormat, std::move(data), std::move(levels) };
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "CompressedImage.hpp"
+#include "MipChain.hpp"
+
+// Encoders for the 4x4 block formats texture_compress writes. Input is always a 4x4 RGBA block, texels in
+// rows of four; edge blocks are padded by the caller. Endpoints are fitted along the block's principal
+// colour axis, which is fast and good enough for albedo textures, not an exhaustive search.
+namespace BlockEncoder {
+    enum class Format { BC1, BC3, BC4, BC5 };
+
+    // GL internal format texture_compress writes for format; srgb only affects BC1 and BC3.
+    [[nodiscard]] GLenum internalFormat(Format format, bool srgb);
+    [[nodiscard]] const char* formatName(Format format);
+    // Encodes every level of the chain. One and two channel chains feed red (and alpha/green).
+    [[nodiscard]] CompressedImage compress(const MipChain& mips, Format format, bool srgb);
+
+    // BC1 in four-colour mode, alpha ignored. 8 bytes.
+    void encodeBC1(const GLubyte (&block)[16][4], GLubyte* out);
+    // BC3: interpolated alpha plus a BC1 colour block. 16 bytes.
+    void encodeBC3(const GLubyte (&block)[16][4], GLubyte* out);
+    // BC4 of one channel. 8 bytes.
+    void encodeBC4(const GLubyte (&block)[16][4], int channel, GLubyte* out);
+    // BC5: BC4 of red, then BC4 of green. 16 bytes.
+    void encodeBC5(const GLubyte (&block)[16][4], GLubyte* out);
+}
@@ -0,0 +1,97 @@
+// Offline converter: PNG/JPG (anything stb_image reads) to a KTX2 file of BC1/BC3/BC4/BC5 blocks with a
+// full mip chain, for Texture and TextureLoader to upload without decoding or mipmapping at run time.
+//
+//     texture_compress [--format auto|bc1|bc3|bc4|bc5] [--srgb] input output.ktx2
+//
+// auto picks BC1 for opaque colour, BC3 when alpha is used, BC4/BC5 for one/two channel images.
+// --srgb marks colour formats as sRGB so sampling decodes them; the exercises render without gamma
+// handling, so the default keeps them UNORM like the RGB8/RGBA8 textures they replace.
+
+#include "BlockEncoder.hpp"
+#include "CompressedImage.hpp"
+#include "MipChain.hpp"
+#include "stb_image.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+    using Format = BlockEncoder::Format;
+
+    // BC1 for opaque colour, BC3 when alpha is used, BC4/BC5 for one/two channel images.
+    Format pickFormat(const GLubyte* pixels, const int width, const int height, const int numChannels) {
+        switch (numChannels) {
+            case 1:
+                return Format::BC4;
+            case 2:
+                return Format::BC5;
+            case 3:
+                return Format::BC1;
+            default:
+                for (std::size_t i = 3; i < static_cast<std::size_t>(width) * height * 4; i += 4) {
+                    if (pixels[i] != 255) {
+                        return Format::BC3;
+                    }
+                }
+                return Format::BC1;
+        }
+    }
+}
+
+int main(const int argc, char** argv) {
+    std::string formatArgument { "auto" };
+    bool srgb { false };
+    std::string input;
+    std::string output;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument { argv[i] };
+        if (argument == "--format" && i + 1 < argc) {
+            formatArgument = argv[++i];
+        } else if (argument == "--srgb") {
+            srgb = true;
+        } else if (input.empty()) {
+            input = argument;
+        } else {
+            output = argument;
+        }
+    }
+    if (input.empty() || output.empty()) {
+        std::cout << "usage: texture_compress [--format auto|bc1|bc3|bc4|bc5] [--srgb] input output.ktx2"
+                  << std::endl;
+        return 1;
+    }
+    if (formatArgument != "auto" && formatArgument != "bc1" && formatArgument != "bc3" && formatArgument != "bc4"
+        && formatArgument != "bc5") {
+        std::cout << "Unknown format: " << formatArgument << " (auto, bc1, bc3, bc4 or bc5)" << std::endl;
+        return 1;
+    }
+
+    // Same orientation as Texture's stb_image path: bottom row first.
+    stbi_set_flip_vertically_on_load(true);
+    int width, height, numChannels;
+    GLubyte* pixels { stbi_load(input.c_str(), &width, &height, &numChannels, STBI_default) };
+    if (!pixels) {
+        std::cout << "Failed to load texture: " << input << std::endl;
+        return 1;
+    }
+    Format format { pickFormat(pixels, width, height, numChannels) };
+    if (formatArgument == "bc1") {
+        format = Format::BC1;
+    } else if (formatArgument == "bc3") {
+        format = Format::BC3;
+    } else if (formatArgument == "bc4") {
+        format = Format::BC4;
+    } else if (formatArgument == "bc5") {
+        format = Format::BC5;
+    }
+    const MipChain mips { MipChain::build(pixels, width, height, numChannels, numChannels >= 3) };
+    stbi_image_free(pixels);
+
+    const CompressedImage image { BlockEncoder::compress(mips, format, srgb) };
+    if (!image.writeKTX2(output)) {
+        return 1;
+    }
+    std::cout << input << " -> " << output << " (" << BlockEncoder::formatName(format) << ", " << image.getLevels().size()
+              << " levels, " << mips.getSize() << " -> " << image.getSize() << " bytes)" << std::endl;
+    return 0;
+}